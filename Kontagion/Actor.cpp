@@ -3,11 +3,28 @@
 
 using namespace std;
 
+Actor::Actor(StudentWorld* sw, int imageID, double startX, double startY, int hp, Direction dir, int depth, double size)
+    : GraphObject(imageID, startX, startY, dir, depth, size)
+{
+    m_isAlive = true;
+    m_world = sw;
+    m_hitPoints = hp;
+    m_categories = 0;
+    m_lifetime = 0;
+    addTo(sw->renderList()); // drawn with the rest of its world
+}
+
 void Actor::increaseHitPoints (int hp) {
     m_hitPoints += hp; // hp may be negative, in this case the actor is taking damage
     if (m_hitPoints <= 0) setDead(); // if the hitpoints fall below or equal to zero, the actor is now dead
 }
 
+void Actor::moveTo(double x, double y) {
+    double oldX = getX(), oldY = getY();
+    GraphObject::moveTo(x, y);
+    m_world->actorMoved(this, oldX, oldY); // let the world re-file this actor in its spatial index
+}
+
 Socrates::Socrates(StudentWorld* sw)
     : Actor(sw, IID_PLAYER, 0, 127, 100, 0, 0)
 {
@@ -17,6 +34,13 @@ Socrates::Socrates(StudentWorld* sw)
         m_positionAngle = 180;
 }
 
+void Actor::setDead() {
+    if (m_isAlive) {
+        m_isAlive = false;
+        m_world->actorDied(this);
+    }
+}
+
 // Socrates needs a separate increaseHitPoints function because he interacts with goodies
 void Socrates::increaseHitPoints (int hp) {
     if (getHitpoints() + hp >= 100) setHitPoints(100); // a maximum of 100 hp is possible
@@ -56,12 +80,8 @@ void Socrates::doSomething() {
                 break;
             case KEY_PRESS_ENTER:
                 if (m_flameThrowerCharges > 0) {
-                    Location newPos;
-                    // similar to spray above except that 16 flames all around Socrates are added
-                    for (int i = 0, j = 0; i < 16; i++, j += 22) {
-                        getPositionInThisDirection(getDirection() + j, 2*SPRITE_RADIUS, newPos.first, newPos.second);
-                        getWorld()->addProjectile(newPos.first, newPos.second, getDirection() + j, FLAME);
-                    }
+                    // similar to spray above except that a ring of 16 flames all around Socrates is added
+                    getWorld()->addFlameBurst(getX(), getY(), getDirection());
                     m_flameThrowerCharges--;
                     getWorld()->playSound(SOUND_PLAYER_FIRE);
                 }
@@ -83,53 +103,165 @@ void Socrates::moveToPositionAngle(double pa) {
     setDirection(m_positionAngle + 180);
 }
 
-DirtPile::DirtPile(StudentWorld* sw, double x, double y) : Actor(sw, IID_DIRT, x, y, 0, 0, 1) {}
+DirtPile::DirtPile(StudentWorld* sw, double x, double y) : Actor(sw, IID_DIRT, x, y, 0, 0, 1) {
+    addCategories(CATEGORY_BLOCKER | CATEGORY_DESTRUCTABLE | CATEGORY_STATIC);
+}
 
 void DirtPile::doSomething() {} // dirt does not do anything
 
+void DirtPile::increaseHitPoints(int hp) {
+    bool wasAlive = isAlive();
+    Actor::increaseHitPoints(hp);
+
+    // a destroyed pile stops blocking movement immediately, not only once it is removed at the end of the tick
+    if (wasAlive && !isAlive())
+        getWorld()->removeObstacle(this);
+}
+
 
 Projectile::Projectile(StudentWorld *sw, int iid, double x, double y, int dir, int td, int dc)
     : Actor(sw, iid, x, y, 0, dir, 1)
 {
-    m_travelDistance = td;
+    m_sweptFromX = x;
+    m_sweptFromY = y;
     m_damageCapacity = dc;
+    addCategories(CATEGORY_PROJECTILE);
+
+    // every projectile has a maximum distance it can go before it dissipates, covered one sprite width per tick
+    setLifetime(td / SPRITE_WIDTH);
 }
 
 void Projectile::doSomething() {
     if (!isAlive())
         return;
+    hitOrMove(getWorld()->firstOverlapAlongPath(m_sweptFromX, m_sweptFromY, getX(), getY()));
+}
 
-    // if the projectile overlaps with something that can be damaged, it is dissipated and the damageable object is damaged
-    Actor* a = getWorld()->overlap(this);
-    if (a != nullptr) {
-        a->increaseHitPoints(-m_damageCapacity);
+// if it has moved enough and there is nothing around to damage, it is the end of the projectile
+void Projectile::expire() {
+    Actor* a = getWorld()->firstOverlapAlongPath(m_sweptFromX, m_sweptFromY, getX(), getY());
+    if (a != nullptr)
+        hit(a);
+    else
         this->setDead();
-        return;
-    }
+}
 
-    // else if it can still move, it continues moving forward in its direction
-    else if (m_travelDistance > 0) {
+// the path since the last check is covered as a whole, which keeps fast bacteria from slipping through
+Actor* Projectile::findTarget(vector<Actor*> &scratch) {
+    return getWorld()->firstOverlapAlongPath(m_sweptFromX, m_sweptFromY, getX(), getY(), scratch);
+}
+
+void Projectile::hitOrMove(Actor* target) {
+    // only deaths can have changed the path since target was found, so if it has died the path is searched again
+    if (target != nullptr && !target->isAlive())
+        target = getWorld()->firstOverlapAlongPath(m_sweptFromX, m_sweptFromY, getX(), getY());
+
+    // if it did not hit anything it continues moving forward in its direction, until the world expires it
+    if (target != nullptr)
+        hit(target);
+    else {
+        m_sweptFromX = getX();
+        m_sweptFromY = getY();
         moveAngle(getDirection(), SPRITE_WIDTH);
-        m_travelDistance -= SPRITE_WIDTH;
     }
+}
 
-    // if it has moved enough and there is nothing around to damage, it is the end of the projectile
-    else
-        this->setDead();
+// what the projectile hit is damaged and the projectile is dissipated
+void Projectile::hit(Actor* target) {
+    target->increaseHitPoints(-m_damageCapacity);
+    this->setDead();
 }
 
 
 Spray::Spray(StudentWorld* sw, double x, double y, int dir) : Projectile (sw, IID_SPRAY, x, y, dir, 112, 2) {}
 
-Flame::Flame(StudentWorld *sw, double x, double y, int dir) : Projectile (sw, IID_FLAME, x, y, dir, 32, 5) {}
+FlameBurst::FlameBurst(StudentWorld *sw, double x, double y, int dir) : Actor(sw, IID_FLAME, x, y, 0, dir, 1) {
+    setVisible(false);
+    addCategories(CATEGORY_PROJECTILE);
+
+    // the flames start just outside Socrates, spread evenly around the direction he is facing
+    m_radius = m_sweptFromRadius = 2 * SPRITE_RADIUS;
+    m_travelDistance = FLAME_TRAVEL_DISTANCE;
+    for (int i = 0; i < FLAME_RAYS; i++) {
+        int angle = dir + i * FLAME_RAY_SPACING;
+        m_rays[i].addTo(sw->renderList());
+        m_rays[i].setDirection(angle);
+        m_rays[i].moveTo(x + m_radius * cosDegrees(angle), y + m_radius * sinDegrees(angle));
+        m_rayAlive[i] = true;
+    }
+}
 
-Food::Food(StudentWorld* sw, double x, double y) : Actor(sw, IID_FOOD, x, y, 0, 90, 1) {}
+void FlameBurst::doSomething() {
+    if (!isAlive())
+        return;
 
-bool Food::isFood() const { return true; } // food is the only actor that is edible
+    // everything the flames could have touched since the last check lies in the band they swept through,
+    // so one query serves every flame; each flame that passed over something damages the first thing on its path
+    const vector<Actor*> &targets = getWorld()->actorsInRing(getX(), getY(), m_sweptFromRadius - SPRITE_WIDTH, m_radius + SPRITE_WIDTH, CATEGORY_BACTERIUM | CATEGORY_DESTRUCTABLE);
+    bool burning = false;
+    for (int i = 0; i < FLAME_RAYS; i++) {
+        if (!m_rayAlive[i])
+            continue;
+        Actor* a = firstTargetOnRay(i, targets);
+        if (a != nullptr) {
+            a->increaseHitPoints(-FLAME_DAMAGE);
+            m_rayAlive[i] = false;
+            m_rays[i].setVisible(false);
+        }
+        else
+            burning = true;
+    }
+
+    // the remaining flames continue outwards until they have gone far enough, then the burst is over
+    if (burning && m_travelDistance > 0) {
+        m_sweptFromRadius = m_radius;
+        m_radius += SPRITE_WIDTH;
+        m_travelDistance -= SPRITE_WIDTH;
+        for (int i = 0; i < FLAME_RAYS; i++) {
+            if (m_rayAlive[i]) {
+                int angle = m_rays[i].getDirection();
+                m_rays[i].moveTo(getX() + m_radius * cosDegrees(angle), getY() + m_radius * sinDegrees(angle));
+            }
+        }
+    }
+    else
+        this->setDead();
+}
+
+// the live target closest to the start of the part of the ray swept since the last check, within a sprite width of
+// it; as for sprays, a bacterium anywhere on that part is hit before dirt or goodies
+Actor* FlameBurst::firstTargetOnRay(int ray, const vector<Actor*> &targets) const {
+    int angle = m_rays[ray].getDirection();
+    double ux = cosDegrees(angle), uy = sinDegrees(angle);
+    Actor* best = nullptr;
+    double bestAlong = 0, bestSquared = 0;
+    for (Actor* a : targets) {
+        if (!a->isAlive()) // already destroyed by another flame of this burst
+            continue;
+        double rx = a->getX() - getX(), ry = a->getY() - getY();
+        double along = max(m_sweptFromRadius, min(m_radius, rx * ux + ry * uy));
+        double squared = distanceSquared(rx, ry, along * ux, along * uy);
+        if (squared > SPRITE_WIDTH * SPRITE_WIDTH)
+            continue;
+        bool first = (best == nullptr || (a->isBacterium() != best->isBacterium() ? a->isBacterium() :
+                (along < bestAlong || (along == bestAlong && squared < bestSquared))));
+        if (first) {
+            best = a;
+            bestAlong = along;
+            bestSquared = squared;
+        }
+    }
+    return best;
+}
+
+Food::Food(StudentWorld* sw, double x, double y) : Actor(sw, IID_FOOD, x, y, 0, 90, 1) {
+    addCategories(CATEGORY_FOOD | CATEGORY_STATIC); // food is the only actor that is edible
+}
 
 void Food::doSomething() {}
 
 Pit::Pit(StudentWorld* sw, double x, double y) : Actor(sw, IID_PIT, x, y, 0, 0, 1) {
+    addCategories(CATEGORY_STATIC);
 
     // initialize the pit with appropriate numbers of each bacteria
     m_rs = 5;
@@ -140,9 +272,19 @@ Pit::Pit(StudentWorld* sw, double x, double y) : Actor(sw, IID_PIT, x, y, 0, 0,
     m_totalInventory = 10;
 
     // the pit initially has all 3 types remaining
-    m_typesRemaining.insert(REGULAR_SALMONELLA);
-    m_typesRemaining.insert(AGGRESSIVE_SALMONELLA);
-    m_typesRemaining.insert(ECOLI);
+    m_typesRemaining[0] = REGULAR_SALMONELLA;
+    m_typesRemaining[1] = AGGRESSIVE_SALMONELLA;
+    m_typesRemaining[2] = ECOLI;
+    m_typeCount = 3;
+}
+
+// takes a type that has run out off the list, keeping the others in order
+void Pit::removeType(int type) {
+    int kept = 0;
+    for (int i = 0; i < m_typeCount; i++)
+        if (m_typesRemaining[i] != type)
+            m_typesRemaining[kept++] = m_typesRemaining[i];
+    m_typeCount = kept;
 }
 
 void Pit::doSomething() {
@@ -156,71 +298,53 @@ void Pit::doSomething() {
         return;
     }
 
-    // first generate a random number to determine whether a bacterium is to be released
-    bool bacteriaIsToBeReleased = (randInt(1, 50) == 1);
-
-
-    if (bacteriaIsToBeReleased) {
+    // the world only wakes the pit on the ticks that a bacterium is to be released, so pick a random type from among the types of bacteria remaining
+    int type = m_typesRemaining[getWorld()->randInt(0, m_typeCount - 1)];
 
-        // generate a random index from among the types of bacteria remaining.
-        int randIndex = randInt(0, m_typesRemaining.size() - 1);
-
-        // iterate to which type of bacteria is to be released
-        std::set<int>::iterator r;
-        int v = 0;
-        for (r = m_typesRemaining.begin(), v = 0; v < randIndex; r++) v++;
-
-        // introduce the appropriate kind of bacterium into the world
-        int type = *r;
-        switch (type) {
-            case REGULAR_SALMONELLA:
-                getWorld()->addBacterium(REGULAR_SALMONELLA, getX(), getY());
-                m_rs--;
-                m_totalInventory--;
-                if (m_rs == 0)
-                    m_typesRemaining.erase(REGULAR_SALMONELLA);
-                break;
-            case AGGRESSIVE_SALMONELLA:
-                getWorld()->addBacterium(AGGRESSIVE_SALMONELLA, getX(), getY());
-                m_as--;
-                m_totalInventory--;
-                if (m_as == 0)
-                    m_typesRemaining.erase(AGGRESSIVE_SALMONELLA);
-                break;
-            case ECOLI:
-                getWorld()->addBacterium(ECOLI, getX(), getY());
-                m_ec--;
-                m_totalInventory--;
-                if (m_ec == 0)
-                    m_typesRemaining.erase(ECOLI);
-                break;
-            default:
-                break;
-        }
+    // introduce the appropriate kind of bacterium into the world
+    switch (type) {
+        case REGULAR_SALMONELLA:
+            getWorld()->addBacterium(REGULAR_SALMONELLA, getX(), getY());
+            m_rs--;
+            m_totalInventory--;
+            if (m_rs == 0)
+                removeType(REGULAR_SALMONELLA);
+            break;
+        case AGGRESSIVE_SALMONELLA:
+            getWorld()->addBacterium(AGGRESSIVE_SALMONELLA, getX(), getY());
+            m_as--;
+            m_totalInventory--;
+            if (m_as == 0)
+                removeType(AGGRESSIVE_SALMONELLA);
+            break;
+        case ECOLI:
+            getWorld()->addBacterium(ECOLI, getX(), getY());
+            m_ec--;
+            m_totalInventory--;
+            if (m_ec == 0)
+                removeType(ECOLI);
+            break;
+        default:
+            break;
     }
 }
 
+// a bacterium is released with a 1 in 50 chance each tick; once the pit is empty it goes away on the next tick
+int Pit::ticksUntilNextAction() const {
+    return (m_totalInventory == 0 ? 1 : getWorld()->rng().trialsUntilOneIn(50));
+}
+
 
 Goodie::Goodie(StudentWorld *sw, int imageID, double x, double y)
     : Actor (sw, imageID, x, y, 0, 0, 1)
 {
     // set lifetime to initial value provided in the spec
-    m_lifetime = max(randInt(0, 300 - 10 * getWorld()->getLevel() - 1), 50);
+    setLifetime(max(getWorld()->randInt(0, 300 - 10 * getWorld()->getLevel() - 1), 50));
+    addCategories(CATEGORY_GOODIE | CATEGORY_DESTRUCTABLE);
 }
 
-void Goodie::doSomething() {
-    if(!isAlive())
-        return;
-
-    // if there is overlap with socrates, help him according to the kind of goodie it is
-    if (getWorld()->overlapWithSocrates(this))
-        takeSpecificGoodieAction();
-    else {
-        m_lifetime--;
-        if (m_lifetime == 0)
-            setDead();
-    }
-}
+// nothing: the world hands Socrates the goodies he overlaps with, and removes the others when their lifetime is over
+void Goodie::doSomething() {}
 
 RestoreHealthGoodie::RestoreHealthGoodie(StudentWorld *sw, double x, double y) : Goodie(sw, IID_RESTORE_HEALTH_GOODIE, x, y) {}
 
@@ -259,211 +383,47 @@ void Fungus::takeSpecificGoodieAction() {
     getWorld()->adjustSocratesHitPoints(-20); // Hurt Socrates by decrementing his hitpoints by 20
 }
 
-Bacterium::Bacterium(StudentWorld *sw, int imageID, int hp, double x, double y, int type, int dc) : Actor(sw, imageID, x, y, hp, 90, 0) {
-    m_movementPlanDistance = 0;
-    m_foodEaten = 0;
-    m_type = type;
-    m_damageCapacity = dc;
+Bacterium::Bacterium(StudentWorld *sw, int imageID, double x, double y, int type) : Actor(sw, imageID, x, y, 0, 90, 0) {
+    m_storeIndex = sw->bacteria().add(this, type, x, y);
+    addCategories(CATEGORY_BACTERIUM);
 }
 
-void Bacterium::updateFoodEaten(int qty) {
-    m_foodEaten += qty;
-}
-
-double Bacterium::computeNewCoordinate(char axis) {
-    double temp1 = (axis == 'x' ? getX() : getY());
-    double temp2 = (axis == 'x' ? VIEW_WIDTH : VIEW_HEIGHT);
-    if (temp1 < (temp2 / 2))
-        return (temp1 + (SPRITE_WIDTH / 2));
-    else if (temp1 > (temp2 / 2))
-        return (temp1 - (SPRITE_WIDTH / 2));
-    return temp1;
-}
+void Bacterium::doSomething() {}
 
 void Bacterium::increaseHitPoints(int hp) {
-    takeDamage(hp);
-}
-
-void Bacterium::takeDamage(int hp) {
-    Actor::increaseHitPoints(hp); // base class function updates hitpoints appropriately
-    switch (getType()) {
-        case REGULAR_SALMONELLA:
-        case AGGRESSIVE_SALMONELLA:
-            if(isAlive())
-                getWorld()->playSound(SOUND_SALMONELLA_HURT);
-            else
-                die(SALMONELLA);
-            break;
-        case ECOLI:
-            if(isAlive())
-                getWorld()->playSound(SOUND_ECOLI_HURT);
-            else
-                die(ECOLI);
-            break;
-        default:
-            break;
-    }
-}
-
-void Bacterium::die(int type) {
-    if (type == SALMONELLA)
-        getWorld()->playSound(SOUND_SALMONELLA_DIE);
-    else
-        getWorld()->playSound(SOUND_ECOLI_DIE);
-    getWorld()->increaseScore(100); // killing any bacteria awards 100 points
-
-    // there is a half chance that the dead bacterium turns into food
-    bool turnIntoFood = (randInt(1, 2)) == 1;
-    if (turnIntoFood)
-        getWorld()->addFood(getX(), getY());
-}
-
-Salmonella::Salmonella(StudentWorld *sw, int hp, double x, double y, int dc) : Bacterium(sw, IID_SALMONELLA, hp, x, y, (dc == 1) ? REGULAR_SALMONELLA : AGGRESSIVE_SALMONELLA, dc) {}
-
-void Bacterium::process1() {
-
-    // if there is an overlap with Socrates, hurt him with damageCapacity
-    if (getWorld()->overlapWithSocrates(this)) {
-        getWorld()->adjustSocratesHitPoints(-m_damageCapacity);
-    }
-
-    // else if enough food has been eaten, divide
-    else if (getFoodEaten() == 3) {
-        getWorld()->addBacterium(getType(), computeNewCoordinate('x'), computeNewCoordinate('y'));
-        updateFoodEaten(-3);
-    }
-
-    // else if there is food nearby, eat it
-    else if (getWorld()->overlapWithFood(this)) {
-        updateFoodEaten(1);
-    }
-}
-
-void Salmonella::process2() {
-
-    // if there is already a path the salmonella is on, continue on that path
-    if (getMovementPlanDist() > 0) {
-        updateMovementPlanDist(-1);
-        Location newPos;
-        getPositionInThisDirection(getDirection(), 3, newPos.first, newPos.second);
-
-        // if there is movement overlap with a dirt pile, pick new random direction to move in
-        if (getWorld()->movementOverlap(newPos.first, newPos.second)) {
-            setDirection(randInt(0, 359));
-            updateMovementPlanDist(10 - getMovementPlanDist());
-        }
-
-        // if no overlap move to next point in path
-        else
-            moveTo(newPos.first, newPos.second);
-    }
-
-    // else get directional angle of the closest food
-    else {
-        Direction newD = 0;
-        Location newPos;
-
-        // if food is indeed found nearby, attempt to move towards it
-        if (getWorld()->findNearbyFoodDirection(this, newD)) {
-            setDirection(newD);
-            getPositionInThisDirection(newD, 3, newPos.first, newPos.second);
-            if (!getWorld()->movementOverlap(newPos.first, newPos.second))
-                moveTo(newPos.first, newPos.second);
-            else {
-                setDirection(randInt(0, 359));
-                updateMovementPlanDist(10 - getMovementPlanDist());
-            }
-        }
-
-        // else set a random new direction to move in
-        else {
-            setDirection(randInt(0, 359));
-            updateMovementPlanDist(10 - getMovementPlanDist());
-        }
-    }
-}
-
-
-RegularSalmonella::RegularSalmonella(StudentWorld *sw, double x, double y) : Salmonella(sw, 4, x, y, 1) {}
-
-void RegularSalmonella::doSomething() {
-    if (!isAlive())
-        return;
-    process1();
-    process2();
+    getWorld()->bacteria().damage(m_storeIndex, -hp);
 }
 
-AggressiveSalmonella::AggressiveSalmonella(StudentWorld *sw, double x, double y) : Salmonella(sw, 10, x, y, 2) {}
+RegularSalmonella::RegularSalmonella(StudentWorld *sw, double x, double y) : Bacterium(sw, IID_SALMONELLA, x, y, REGULAR_SALMONELLA) {}
 
-void AggressiveSalmonella::doSomething() {
-    if(!isAlive())
-        return;
-    Direction newD;
-    Location newPos;
-    bool flag = true; // flag to check if Step 6 from the spec has to be performed
-    if (getWorld()->findSocratesNearby(this, 72, newD)) {
-        flag = false;
-        setDirection(newD);
-        getPositionInThisDirection(newD, 3, newPos.first, newPos.second);
-        if (!getWorld()->movementOverlap(newPos.first, newPos.second)) {
-            moveTo(newPos.first, newPos.second);
-        }
-    }
-    process1();
-    if (flag) {
-        process2();
-    }
-}
+AggressiveSalmonella::AggressiveSalmonella(StudentWorld *sw, double x, double y) : Bacterium(sw, IID_SALMONELLA, x, y, AGGRESSIVE_SALMONELLA) {}
 
-Ecoli::Ecoli(StudentWorld *sw, double x, double y) : Bacterium(sw, IID_ECOLI, 5, x, y, ECOLI, 4) {}
-
-void Ecoli::doSomething() {
-    if(!isAlive())
-        return;
-    process1();
-    Direction newD;
-
-    // if socrates is within 256 pixels, try to get to him
-    if (getWorld()->findSocratesNearby(this, 256, newD)) {
-        Location newPos;
-        int i = 0;
-        setDirection(newD);
-
-        // 10 tries to make a move, if not possible, the ecoli stays put
-        while (i < 10) {
-            getPositionInThisDirection(newD, 2, newPos.first, newPos.second);
-            if (getWorld()->movementOverlap(newPos.first, newPos.second)) {
-                newD = (newD + 10) % 360;
-                setDirection(newD);
-            }
-            else {
-                moveTo(newPos.first, newPos.second);
-                return;
-            }
-            i++;
-        }
-    }
-}
+Ecoli::Ecoli(StudentWorld *sw, double x, double y) : Bacterium(sw, IID_ECOLI, x, y, ECOLI) {}
 
 
 // Auxiliary Functions
 
 // euclidean distance between two points
 double distance (double x1, double y1, double x2, double y2) {
-    return sqrt(pow(abs(x1 - x2), 2) + pow(abs(y1 - y2), 2));
+    return sqrt(distanceSquared(x1, y1, x2, y2));
+}
+
+// square of the euclidean distance, for comparing against a squared threshold without taking a root
+double distanceSquared (double x1, double y1, double x2, double y2) {
+    return (x1 - x2) * (x1 - x2) + (y1 - y2) * (y1 - y2);
 }
 
 // return x-coordinate from center of dish at a given distance at a given angle
 double xCoordinateFromCenter (double dist, int angle) {
-    return ((VIEW_WIDTH / 2) + dist * cos (angle * (PI/180)));
+    return ((VIEW_WIDTH / 2) + dist * cosDegrees(angle));
 }
 
 // same as xCoordinateFromCenter except it returns the y-coordinate
 double yCoordinateFromCenter (double dist, int angle) {
-    return ((VIEW_HEIGHT / 2) + dist * sin (angle * (PI/180)));
+    return ((VIEW_HEIGHT / 2) + dist * sinDegrees(angle));
 }
 
-// uses the arctan(2) function to compute the direction in which one object lies relative to another
-double angleBetweenPositions(double x1, double y1, double x2, double y2) {
-    return (atan2(y1 - y2, x1 - x2) * (180 / PI));
+// direction in whole degrees in which (x1, y1) lies as seen from (x2, y2), truncated towards zero like atan2 would be
+int angleBetweenPositions(double x1, double y1, double x2, double y2) {
+    return quantizedAtan2(y1 - y2, x1 - x2);
 }
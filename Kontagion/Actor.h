@@ -2,7 +2,9 @@
 #define ACTOR_H_
 
 #include "GraphObject.h"
+#include "ActorHandle.h"
 #include <algorithm>
+#include <vector>
 
 
 #define REGULAR_SALMONELLA 1
@@ -10,41 +12,66 @@
 #define ECOLI 3
 #define SALMONELLA 1
 
-// Students:  Add code to this file, Actor.cpp, StudentWorld.h, and StudentWorld.cpp
+// categories an actor can belong to, combined into a bitmask that is stored directly in the Actor
+#define CATEGORY_BACTERIUM 0x01
+#define CATEGORY_DESTRUCTABLE 0x02
+#define CATEGORY_FOOD 0x04
+#define CATEGORY_BLOCKER 0x08
+#define CATEGORY_PROJECTILE 0x10
+#define CATEGORY_GOODIE 0x20
+#define CATEGORY_STATIC 0x40 // never moves and only changes when something happens to it
+
+#define FLAME_RAYS 16 // flames in one flamethrower burst
+#define FLAME_RAY_SPACING 22 // degrees between neighbouring flames
+#define FLAME_TRAVEL_DISTANCE 32 // how far the flames go before they dissipate
+#define FLAME_DAMAGE 5 // hit points a flame takes from what it hits
 
-const double PI = atan(1) * 4;
+// Students:  Add code to this file, Actor.cpp, StudentWorld.h, and StudentWorld.cpp
 
 double distance (double x1, double y1, double x2, double y2);
+double distanceSquared (double x1, double y1, double x2, double y2);
 double xCoordinateFromCenter (double dist, int angle);
 double yCoordinateFromCenter (double dist, int angle);
-double angleBetweenPositions (double x1, double y1, double x2, double y2);
+int angleBetweenPositions (double x1, double y1, double x2, double y2);
 
 class StudentWorld;
 
+// Actors are dropped together with their level without running their destructors (see LevelArena), so no actor
+// may own anything that needs cleaning up, such as a std::set or a std::vector.
 class Actor: public GraphObject { // base class for all of the other objects in the game
 public:
-    Actor(StudentWorld* sw, int imageID, double startX, double startY, int hp, Direction dir = 0, int depth = 0, double size = 1.0) : GraphObject(imageID, startX, startY, dir, depth, size) {
-        m_isAlive = true;
-        m_world = sw;
-        m_hitPoints = hp;
-    }
+    Actor(StudentWorld* sw, int imageID, double startX, double startY, int hp, Direction dir = 0, int depth = 0, double size = 1.0);
     bool isAlive() { return m_isAlive; }
-    void setDead() { m_isAlive = false; }
+    void setDead(); // also tells the world, which removes the actor after the current update phase
     int getHitpoints() const { return m_hitPoints; }
     void setHitPoints(int hp) { m_hitPoints = hp; }
     virtual void increaseHitPoints (int hp);
     StudentWorld* getWorld() const { return m_world; }
+    virtual void moveTo(double x, double y); // keeps the world's spatial index in sync with the new position
     virtual void doSomething() = 0;
-    virtual bool isDestructable() const { return false; }
-    virtual bool isBacterium() const { return false; }
-    virtual bool isFood() const { return false; }
-    virtual bool blocksMovement() const { return false ; }
+    int getLifetime() const { return m_lifetime; }
+    virtual void expire() { setDead(); } // called by the world once the lifetime has run out
+    ActorHandle getHandle() const { return m_handle; }
+    void setHandle(ActorHandle h) { m_handle = h; } // only for use by the world when the actor is spawned
+    int getCategories() const { return m_categories; }
+    bool isDestructable() const { return (m_categories & CATEGORY_DESTRUCTABLE) != 0; }
+    bool isBacterium() const { return (m_categories & CATEGORY_BACTERIUM) != 0; }
+    bool isFood() const { return (m_categories & CATEGORY_FOOD) != 0; }
+    bool blocksMovement() const { return (m_categories & CATEGORY_BLOCKER) != 0; }
+    bool isStatic() const { return (m_categories & CATEGORY_STATIC) != 0; }
     virtual ~Actor() = default;
-    
+
+protected:
+    void addCategories(int categories) { m_categories |= categories; } // only for use in the constructors
+    void setLifetime(int ticks) { m_lifetime = ticks; } // likewise; the world expires the actor that many ticks after it spawned
+
 private:
     bool m_isAlive; // variable to keep track of dead/alive status
     int m_hitPoints; // variable to keep track of hitpoints remaining
     StudentWorld* m_world; // pointer to Student world object
+    int m_categories; // bitmask of CATEGORY_ flags saying what kind of actor this is
+    int m_lifetime; // ticks the actor lasts before expire() is called, or 0 for as long as it stays alive
+    ActorHandle m_handle; // how the rest of the world can refer to this actor safely across ticks
 };
 
 class Socrates: public Actor {
@@ -78,40 +105,49 @@ class DirtPile: public Actor {
 public:
     DirtPile(StudentWorld* sw, double x, double y);
     virtual void doSomething();
+    virtual void increaseHitPoints (int hp);
 
 
     inline
     virtual ~DirtPile() = default;
-    virtual bool blocksMovement() const { return true; }
-    virtual bool isDestructable() const { return true; }
 };
 
 class Pit: public Actor {
 public:
     Pit(StudentWorld* sw, double x, double y);
-    virtual void doSomething();
+    virtual void doSomething(); // only called by the world on the ticks the pit has something to do
+    int ticksUntilNextAction() const;
 
     inline
-    virtual ~Pit() { m_typesRemaining.clear(); } // empty the typesRemaining set before destructing it
+    virtual ~Pit() = default;
 private:
     int m_rs; // regular salmonella inventory
     int m_as; // aggressive salmonella inventory
     int m_ec; // E.coli inventory
     int m_totalInventory; // variable to keep track of total bacteria remaining
-    std::set<int> m_typesRemaining; // set to keep track of the types of bacteria remaining
+    int m_typesRemaining[3]; // the types of bacteria remaining, in increasing order
+    int m_typeCount; // how many entries of m_typesRemaining are in use
+    void removeType(int type);
 };
 
 class Projectile: public Actor { // class to represent sprays and flames since they share many common features
 public:
     Projectile(StudentWorld *sw, int iid, double x, double y, int dir, int td, int dc); // td for travel distance
     virtual void doSomething();
+    virtual void expire(); // it has moved as far as it can, and dissipates after one last check for a hit
+
+    // doSomething() in two steps: the first only reads the world, so that many projectiles can take it at once
+    Actor* findTarget(std::vector<Actor*> &scratch); // what it hits on the path swept since the last check, if anything
+    void hitOrMove(Actor* target); // target is what findTarget() returned; looks again if it has died since
 
     inline
     virtual ~Projectile() = default;
 
 private:
-    int m_travelDistance; // every projectile has a maximum distance it can go before it dissipates
+    double m_sweptFromX; // where the projectile was when it last checked for hits,
+    double m_sweptFromY; // so that the next check covers the whole path travelled since
     int m_damageCapacity; // every projectile can deal a certain amount of damage to whatever it overlaps with
+    void hit(Actor* target);
 };
 
 class Spray: public Projectile {
@@ -122,19 +158,33 @@ public:
     virtual ~Spray() = default;
 };
 
-class Flame: public Projectile {
+class FlameBurst: public Actor { // one flamethrower blast: a ring of flames moving outwards from Socrates together
 public:
-    Flame (StudentWorld* sw, double x, double y, int dir);
+    FlameBurst (StudentWorld* sw, double x, double y, int dir);
+    virtual void doSomething();
 
     inline
-    virtual ~Flame() = default;
+    virtual ~FlameBurst() = default;
+
+private:
+    class RaySprite: public GraphObject { // what is drawn for one flame; the burst itself is invisible and does all the work
+    public:
+        RaySprite() : GraphObject(IID_FLAME, 0, 0, 0, 1) {} // added to the world's render list by the burst
+    };
+
+    Actor* firstTargetOnRay (int ray, const std::vector<Actor*> &targets) const;
+
+    RaySprite m_rays[FLAME_RAYS]; // kept inline so that a whole burst is a single allocation
+    bool m_rayAlive[FLAME_RAYS]; // a flame goes out once it has damaged something
+    double m_radius; // how far the flames currently are from the center of the burst
+    double m_sweptFromRadius; // how far they were at the last check, so that the next check covers the whole path since
+    int m_travelDistance; // how much further the flames can go before they dissipate
 };
 
 class Food: public Actor {
 public:
     Food (StudentWorld* sw, double x, double y);
     virtual void doSomething();
-    virtual bool isFood() const;
 
     inline
     virtual ~Food() = default;
@@ -148,9 +198,6 @@ public:
 
     inline
     virtual ~Goodie() = default;
-    virtual bool isDestructable() const { return true; }
-private:
-    int m_lifetime; // every goodie has a lifetime
 };
 
 class RestoreHealthGoodie: public Goodie {
@@ -189,54 +236,32 @@ public:
     virtual ~Fungus() = default;
 };
 
-class Bacterium: public Actor {
+class Bacterium: public Actor { // what is drawn for a bacterium; its state and behavior live in the world's BacteriaStore
 public:
-    Bacterium(StudentWorld *sw, int imageID, int hp, double x, double y, int type, int dc);
-    void updateFoodEaten(int qty); // function to update food eaten
-    virtual void doSomething() = 0; // doSomething is pure virtual because behavior varies among the 3 kinds of bacteria
-    void takeDamage(int hp); // helper function for increaseHitPoints
-    void process1(); // common process of doSomething for all bacteria
-    virtual void increaseHitPoints(int hp); // custom function required for bacteria because they are to make sounds
-    void die(int type); // function to handle what is to happen when the bacterium dies
-    double computeNewCoordinate(char axis); // function for computing new coordinate according to the spec
+    Bacterium(StudentWorld *sw, int imageID, double x, double y, int type);
+    virtual void doSomething(); // nothing: the world runs every bacterium at once through its BacteriaStore
+    virtual void increaseHitPoints(int hp); // hp is negative when the bacterium takes damage
+    int getStoreIndex() const { return m_storeIndex; }
+    void setStoreIndex(int index) { m_storeIndex = index; } // only for use by the BacteriaStore
 
     inline
     virtual ~Bacterium() = default;
-    int getFoodEaten() const { return m_foodEaten; }
-    int getMovementPlanDist() const { return m_movementPlanDistance; }
-    void updateMovementPlanDist (int qty) { m_movementPlanDistance += qty; }
-    int getType() const { return m_type ; }
-    virtual bool isBacterium() const { return true; }
 private:
-    int m_movementPlanDistance; // remaining movement plan distance
-    int m_foodEaten; // how much food the bacteria has consumed
-    int m_type; // type of bacteria required for doSomething() processing
-    int m_damageCapacity; // how much damage does the bacteria deal to Socrates in one tick when it overlaps with him
-};
-
-class Salmonella: public Bacterium {
-public:
-    Salmonella(StudentWorld *sw, int hp, double x, double y, int dc);
-    virtual void process2();
-
-    inline
-    virtual ~Salmonella() = default;
+    int m_storeIndex; // where the bacterium's state is kept in the BacteriaStore
 };
 
-class RegularSalmonella: public Salmonella {
+class RegularSalmonella: public Bacterium {
 public:
     RegularSalmonella(StudentWorld *sw, double x, double y);
-    virtual void doSomething();
-    
+
     inline
     virtual ~RegularSalmonella() = default;
 };
 
-class AggressiveSalmonella: public Salmonella {
+class AggressiveSalmonella: public Bacterium {
 public:
     AggressiveSalmonella(StudentWorld *sw, double x, double y);
-    virtual void doSomething();
-    
+
     inline
     virtual ~AggressiveSalmonella() = default;
 };
@@ -244,8 +269,7 @@ public:
 class Ecoli: public Bacterium {
 public:
     Ecoli(StudentWorld *sw, double x, double y);
-    virtual void doSomething();
-    
+
     inline
     virtual ~Ecoli() = default;
 };
@@ -0,0 +1,50 @@
+#include "ActorHandle.h"
+#include <algorithm>
+
+using namespace std;
+
+namespace {
+    const int RESERVED_SLOTS = 512; // more actors than a level usually has at once
+}
+
+HandleTable::HandleTable() {
+    m_firstGeneration = 0;
+    m_highestGeneration = 0;
+    m_slots.reserve(RESERVED_SLOTS);
+    m_free.reserve(RESERVED_SLOTS);
+}
+
+ActorHandle HandleTable::issue(Actor *a) {
+    int slot;
+    if (!m_free.empty()) {
+        slot = m_free.back();
+        m_free.pop_back();
+    }
+    else {
+        slot = (int) m_slots.size();
+        m_slots.push_back(Slot{nullptr, m_firstGeneration});
+    }
+    m_slots[slot].actor = a;
+    return ActorHandle{slot, m_slots[slot].generation};
+}
+
+void HandleTable::release(ActorHandle h) {
+    if (lookup(h) == nullptr)
+        return;
+    m_slots[h.slot].actor = nullptr;
+    m_slots[h.slot].generation++;
+    m_highestGeneration = max(m_highestGeneration, m_slots[h.slot].generation);
+    m_free.push_back(h.slot);
+}
+
+Actor* HandleTable::lookup(ActorHandle h) const {
+    if (h.slot < 0 || h.slot >= (int) m_slots.size() || m_slots[h.slot].generation != h.generation)
+        return nullptr;
+    return m_slots[h.slot].actor;
+}
+
+void HandleTable::clear() {
+    m_slots.clear();
+    m_free.clear();
+    m_firstGeneration = ++m_highestGeneration;
+}
@@ -0,0 +1,43 @@
+#ifndef ACTORHANDLE_H_
+#define ACTORHANDLE_H_
+
+#include <vector>
+#include <cstdint>
+
+class Actor;
+
+// Names an actor without pointing at it, so it can be kept across ticks. The slot says where in the handle table
+// the actor is registered; the generation tells apart the actors that have used the same slot over time, so that a
+// handle to an actor that has since been removed is recognized as stale instead of finding whoever came after it.
+struct ActorHandle {
+    int slot = -1;
+    uint32_t generation = 0;
+
+    bool isNull() const { return slot < 0; }
+    bool operator==(const ActorHandle &other) const { return slot == other.slot && generation == other.generation; }
+    bool operator!=(const ActorHandle &other) const { return !(*this == other); }
+};
+
+// Hands out handles and turns them back into actors in constant time. Slots of removed actors are reused, with
+// their generation moved on so that the old handles no longer match. After clear() new slots start above every
+// generation issued so far, which is what lets clear() drop all slots at once.
+class HandleTable {
+public:
+    HandleTable();
+    ActorHandle issue(Actor* a);
+    void release(ActorHandle h); // the actor is about to be deleted, its handles go stale
+    Actor* lookup(ActorHandle h) const; // nullptr for null and stale handles
+    void clear(); // releases everything in constant time, e.g. between levels
+
+private:
+    struct Slot {
+        Actor* actor;
+        uint32_t generation;
+    };
+    std::vector<Slot> m_slots;
+    std::vector<int> m_free; // slots without an actor, most recently released last
+    uint32_t m_firstGeneration; // generation of slots created since the last clear
+    uint32_t m_highestGeneration; // highest generation any slot has reached
+};
+
+#endif // ACTORHANDLE_H_
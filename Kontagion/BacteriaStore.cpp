@@ -0,0 +1,317 @@
+#include "BacteriaStore.h"
+#include "StudentWorld.h"
+#include "WorkerPool.h"
+
+using namespace std;
+
+namespace {
+    // indexed by bacterium type
+    const int STARTING_HIT_POINTS[] = {0, 4, 10, 5};
+    const int DAMAGE_TO_SOCRATES[] = {0, 1, 2, 4};
+    const int PURSUIT_RANGE[] = {0, 0, 72, 256}; // how close Socrates has to be for the bacterium to go after him
+    const int BLOCK = 256; // bacteria decided on by one thread at a time in the first phase of a two-phase tick
+    const int RESERVED_BACTERIA = 256; // room in each array before the first one grows
+
+    // where the offspring of a bacterium at c appears: half a sprite closer to the middle of the dish
+    double offspringCoordinate(double c, double size) {
+        if (c < size / 2)
+            return c + SPRITE_WIDTH / 2;
+        else if (c > size / 2)
+            return c - SPRITE_WIDTH / 2;
+        return c;
+    }
+}
+
+BacteriaStore::BacteriaStore(StudentWorld* world) {
+    m_world = world;
+    m_x.reserve(RESERVED_BACTERIA);
+    m_y.reserve(RESERVED_BACTERIA);
+    m_direction.reserve(RESERVED_BACTERIA);
+    m_hitPoints.reserve(RESERVED_BACTERIA);
+    m_plan.reserve(RESERVED_BACTERIA);
+    m_food.reserve(RESERVED_BACTERIA);
+    m_type.reserve(RESERVED_BACTERIA);
+    m_changed.reserve(RESERVED_BACTERIA);
+    m_proxy.reserve(RESERVED_BACTERIA);
+}
+
+int BacteriaStore::add(Bacterium* proxy, int type, double x, double y) {
+    m_x.push_back(x);
+    m_y.push_back(y);
+    m_direction.push_back(90);
+    m_hitPoints.push_back(STARTING_HIT_POINTS[type]);
+    m_plan.push_back(0);
+    m_food.push_back(0);
+    m_type.push_back(type);
+    m_changed.push_back(false);
+    m_proxy.push_back(proxy);
+    return size() - 1;
+}
+
+void BacteriaStore::remove(int index) {
+    int last = size() - 1;
+    if (index != last) {
+        m_x[index] = m_x[last];
+        m_y[index] = m_y[last];
+        m_direction[index] = m_direction[last];
+        m_hitPoints[index] = m_hitPoints[last];
+        m_plan[index] = m_plan[last];
+        m_food[index] = m_food[last];
+        m_type[index] = m_type[last];
+        m_changed[index] = m_changed[last];
+        m_proxy[index] = m_proxy[last];
+        m_proxy[index]->setStoreIndex(index);
+    }
+    m_x.pop_back();
+    m_y.pop_back();
+    m_direction.pop_back();
+    m_hitPoints.pop_back();
+    m_plan.pop_back();
+    m_food.pop_back();
+    m_type.pop_back();
+    m_changed.pop_back();
+    m_proxy.pop_back();
+}
+
+void BacteriaStore::clear() {
+    m_x.clear();
+    m_y.clear();
+    m_direction.clear();
+    m_hitPoints.clear();
+    m_plan.clear();
+    m_food.clear();
+    m_type.clear();
+    m_changed.clear();
+    m_proxy.clear();
+    m_feeding.clear();
+}
+
+void BacteriaStore::update() {
+    // bacteria born during the tick are added at the end and start acting next tick
+    int n = size();
+    for (int i = 0; i < n; i++)
+        if (m_hitPoints[i] > 0)
+            act(i, m_world->rng(), nullptr);
+    syncProxies();
+}
+
+void BacteriaStore::updateInTwoPhases(WorkerPool &workers) {
+    int n = size();
+    m_feeding.reserve(RESERVED_BACTERIA); // as much room as the other arrays start with; nothing after the first tick
+    m_feeding.resize(n);
+    uint64_t tick = m_world->rng().next();
+
+    // the paths to Socrates are brought up to date first if anyone is going to follow them, so that nothing is
+    // rebuilt while the bacteria read them
+    Direction unused;
+    for (int i = 0; i < n; i++) {
+        if (m_hitPoints[i] > 0 && PURSUIT_RANGE[m_type[i]] > 0 && m_world->findSocratesNearby(m_x[i], m_y[i], PURSUIT_RANGE[m_type[i]], unused)) {
+            m_world->updatePathsToSocrates();
+            break;
+        }
+    }
+
+    // phase 1: each bacterium only writes its own entries of the arrays, whichever thread it is on
+    workers.parallelFor(n, BLOCK, [&](int begin, int end, int) {
+        for (int i = begin; i < end; i++) {
+            if (m_hitPoints[i] <= 0) {
+                m_feeding[i].action = NOTHING;
+                continue;
+            }
+            ActorHandle h = m_proxy[i]->getHandle();
+            RandomEngine random(tick ^ ((uint64_t) h.generation << 32 | (uint32_t) h.slot));
+            act(i, random, &m_feeding[i]);
+        }
+    });
+
+    // phase 2: everything that touches the rest of the world, in store order
+    for (int i = 0; i < n; i++)
+        feed(i, m_feeding[i]);
+    syncProxies();
+}
+
+void BacteriaStore::damage(int index, int hp) {
+    if (m_hitPoints[index] <= 0)
+        return;
+    m_hitPoints[index] -= hp;
+    bool salmonella = (m_type[index] != ECOLI);
+    if (m_hitPoints[index] > 0) {
+        m_world->playSound(salmonella ? SOUND_SALMONELLA_HURT : SOUND_ECOLI_HURT);
+        return;
+    }
+
+    m_proxy[index]->setDead();
+    m_world->playSound(salmonella ? SOUND_SALMONELLA_DIE : SOUND_ECOLI_DIE);
+    m_world->increaseScore(100); // killing any bacteria awards 100 points
+
+    // there is a half chance that the dead bacterium turns into food
+    bool turnIntoFood = (m_world->randInt(1, 2)) == 1;
+    if (turnIntoFood)
+        m_world->addFood(m_x[index], m_y[index]);
+}
+
+void BacteriaStore::act(int i, RandomEngine &random, Feeding* deferred) {
+    // an aggressive salmonella that is chasing Socrates does not wander
+    bool chasing = (m_type[i] == AGGRESSIVE_SALMONELLA && chase(i, PURSUIT_RANGE[AGGRESSIVE_SALMONELLA]));
+    Feeding f = planFeeding(i);
+    if (deferred != nullptr)
+        *deferred = f;
+    else
+        feed(i, f);
+    switch (m_type[i]) {
+        case REGULAR_SALMONELLA:
+            wander(i, random, f.food);
+            break;
+        case AGGRESSIVE_SALMONELLA:
+            if (!chasing)
+                wander(i, random, f.food);
+            break;
+        case ECOLI:
+            pursue(i);
+            break;
+        default:
+            break;
+    }
+}
+
+BacteriaStore::Feeding BacteriaStore::planFeeding(int i) const {
+    Feeding f{NOTHING, nullptr, m_x[i], m_y[i]};
+
+    // if there is an overlap with Socrates, hurt him with damageCapacity
+    if (m_world->overlapWithSocrates(f.x, f.y))
+        f.action = HURT_SOCRATES;
+
+    // else if enough food has been eaten, divide
+    else if (m_food[i] == 3)
+        f.action = DIVIDE;
+
+    // else if there is food nearby, eat it
+    else if ((f.food = m_world->foodAt(f.x, f.y)) != nullptr)
+        f.action = EAT;
+    return f;
+}
+
+void BacteriaStore::feed(int i, const Feeding &f) {
+    switch (f.action) {
+        case HURT_SOCRATES:
+            m_world->adjustSocratesHitPoints(-DAMAGE_TO_SOCRATES[m_type[i]]);
+            break;
+        case DIVIDE:
+            m_world->addBacterium(m_type[i], offspringCoordinate(f.x, VIEW_WIDTH), offspringCoordinate(f.y, VIEW_HEIGHT));
+            m_food[i] -= 3;
+            break;
+        case EAT: {
+            // food another bacterium got to first is gone, but there may be more within reach
+            Actor* food = (f.food->isAlive() ? f.food : m_world->foodAt(f.x, f.y));
+            if (food == nullptr)
+                break;
+
+            // eaten food is dead, so no other bacterium can find it this tick; it leaves the food index at the next merge
+            food->setDead();
+            m_food[i]++;
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+void BacteriaStore::wander(int i, RandomEngine &random, const Actor* eaten) {
+    double newX, newY;
+
+    // if there is already a path the salmonella is on, continue on that path
+    if (m_plan[i] > 0) {
+        m_plan[i]--;
+        stepFrom(i, m_direction[i], 3, newX, newY);
+
+        // if there is movement overlap with a dirt pile, pick new random direction to move in
+        if (m_world->movementOverlap(newX, newY)) {
+            setDirection(i, random.randInt(0, 359));
+            m_plan[i] = 10;
+        }
+
+        // if no overlap move to next point in path
+        else
+            moveTo(i, newX, newY);
+        return;
+    }
+
+    // else if food is found nearby, attempt to move towards it
+    Direction newD = 0;
+    if (m_world->findNearbyFoodDirection(m_x[i], m_y[i], newD, eaten)) {
+        setDirection(i, newD);
+        stepFrom(i, newD, 3, newX, newY);
+        if (!m_world->movementOverlap(newX, newY))
+            moveTo(i, newX, newY);
+        else {
+            setDirection(i, random.randInt(0, 359));
+            m_plan[i] = 10;
+        }
+    }
+
+    // else set a random new direction to move in
+    else {
+        setDirection(i, random.randInt(0, 359));
+        m_plan[i] = 10;
+    }
+}
+
+bool BacteriaStore::chase(int i, int dist) {
+    Direction newD;
+    if (!m_world->findPathToSocrates(m_x[i], m_y[i], dist, newD))
+        return false;
+    double newX, newY;
+    setDirection(i, newD);
+    stepFrom(i, newD, 3, newX, newY);
+    if (!m_world->movementOverlap(newX, newY))
+        moveTo(i, newX, newY);
+    return true;
+}
+
+void BacteriaStore::pursue(int i) {
+    // if socrates is within 256 pixels, follow the shared path field towards him
+    Direction newD;
+    if (!m_world->findPathToSocrates(m_x[i], m_y[i], PURSUIT_RANGE[ECOLI], newD))
+        return;
+
+    // should a dirt pile still be in the way, 10 headings, 10 degrees apart, are tried in one pass
+    // if none is open, the ecoli stays put
+    Direction openD;
+    if (m_world->firstOpenHeading(m_x[i], m_y[i], newD, 2, 10, 10, openD)) {
+        double newX, newY;
+        setDirection(i, openD);
+        stepFrom(i, openD, 2, newX, newY);
+        moveTo(i, newX, newY);
+    }
+    else
+        setDirection(i, newD + 100); // the ecoli ends up facing past the last heading it tried
+}
+
+void BacteriaStore::setDirection(int i, int d) {
+    m_direction[i] = (int16_t) normalizeDegrees(d);
+    m_changed[i] = true;
+}
+
+void BacteriaStore::moveTo(int i, double x, double y) {
+    m_x[i] = x;
+    m_y[i] = y;
+    m_changed[i] = true;
+}
+
+void BacteriaStore::stepFrom(int i, int d, int units, double &x, double &y) const {
+    x = m_x[i] + units * cosDegrees(d);
+    y = m_y[i] + units * sinDegrees(d);
+}
+
+// the proxies are what gets drawn and what the spatial index knows about, so they follow once per tick
+void BacteriaStore::syncProxies() {
+    for (int i = 0; i < size(); i++) {
+        if (!m_changed[i])
+            continue;
+        Bacterium* proxy = m_proxy[i];
+        proxy->setDirection(m_direction[i]);
+        if (proxy->getX() != m_x[i] || proxy->getY() != m_y[i])
+            proxy->moveTo(m_x[i], m_y[i]);
+        m_changed[i] = false;
+    }
+}
@@ -0,0 +1,79 @@
+#ifndef BACTERIASTORE_H_
+#define BACTERIASTORE_H_
+
+#include "RandomEngine.h"
+#include <vector>
+#include <cstdint>
+
+class StudentWorld;
+class Bacterium;
+class Actor;
+class WorkerPool;
+
+// Simulation state of every bacterium in the dish, one packed array per field, so that a tick of bacteria behavior
+// walks a few contiguous arrays instead of chasing a pointer to a separate object per bacterium. The Bacterium
+// actors are only proxies that draw the bacteria and let projectiles find and damage them; they are brought up to
+// date in one pass at the end of each update. At about 32 bytes per bacterium, ten thousand of them fit in a
+// 512 KB L2 cache. The feedings that a two-phase tick (below) keeps between its phases add as much again, but
+// update() does without them. A bacterium whose hit points have run out is dead and is skipped until it is removed.
+//
+// A tick can also run in two phases, which spreads the bacteria over the threads of a WorkerPool:
+//   1. every bacterium decides what to do at the same time, against the world as it was when the phase started.
+//      It moves itself, since no bacterium looks at where the others are, and notes how it feeds; its random
+//      numbers come from its own stream, keyed by its handle and a number drawn once for the tick.
+//   2. the feedings are then carried out one bacterium at a time, in store order. When two bacteria go for the
+//      same food, the first one in store order eats it and the other eats the nearest food still left within
+//      reach, if any; Socrates takes the damage of every bacterium touching him.
+// So the result does not depend on how many threads there are. It differs from update() only in that a bacterium
+// heading for food still sees food that another one eats in the same tick.
+class BacteriaStore {
+public:
+    explicit BacteriaStore(StudentWorld* world);
+    int add(Bacterium* proxy, int type, double x, double y); // returns the index the bacterium is stored at
+    void remove(int index); // the last bacterium takes its place, and its proxy is told so
+    void clear();
+    int size() const { return (int) m_proxy.size(); }
+
+    void update(); // one tick of behavior for every bacterium that was alive when the tick started
+    void updateInTwoPhases(WorkerPool &workers); // the same, decided in parallel and then committed in order
+    void damage(int index, int hp); // hp is how many hit points are lost
+
+    double x(int index) const { return m_x[index]; }
+    double y(int index) const { return m_y[index]; }
+    int type(int index) const { return m_type[index]; }
+    int hitPoints(int index) const { return m_hitPoints[index]; }
+
+private:
+    enum FeedAction : int8_t { NOTHING, HURT_SOCRATES, DIVIDE, EAT };
+    struct Feeding {
+        FeedAction action;
+        Actor* food; // the food to eat
+        double x, y; // where the bacterium was when it decided
+    };
+
+    StudentWorld* m_world;
+    std::vector<double> m_x;
+    std::vector<double> m_y;
+    std::vector<int16_t> m_direction;
+    std::vector<int16_t> m_hitPoints;
+    std::vector<int8_t> m_plan; // remaining movement plan distance of salmonella
+    std::vector<int8_t> m_food; // how much food the bacterium has eaten since it last divided
+    std::vector<int8_t> m_type; // REGULAR_SALMONELLA, AGGRESSIVE_SALMONELLA or ECOLI
+    std::vector<uint8_t> m_changed; // position or direction changed since the proxy was last brought up to date
+    std::vector<Bacterium*> m_proxy;
+    std::vector<Feeding> m_feeding; // how each bacterium feeds this tick, kept between the two phases only
+
+    void act(int i, RandomEngine &random, Feeding* deferred); // feeds at once, or leaves the feeding in *deferred
+    Feeding planFeeding(int i) const; // hurt Socrates, divide or eat, common to all bacteria
+    void feed(int i, const Feeding &f);
+    void wander(int i, RandomEngine &random, const Actor* eaten); // salmonella movement: follow the plan, head for
+                                                                   // food (not the one just eaten) or pick a random direction
+    bool chase(int i, int dist); // follow the paths to Socrates if he is within dist, aggressive salmonella style
+    void pursue(int i); // the same for E. coli, which tries several headings when dirt is in the way
+    void setDirection(int i, int d);
+    void moveTo(int i, double x, double y);
+    void stepFrom(int i, int d, int units, double &x, double &y) const;
+    void syncProxies();
+};
+
+#endif // BACTERIASTORE_H_
@@ -0,0 +1,131 @@
+#include "FlowField.h"
+#include "Actor.h"
+#include <algorithm>
+
+using namespace std;
+
+namespace {
+    const double SEED_RADIUS = 2 * SPRITE_WIDTH; // cells this close to the target are reached in a straight line
+    const double DETOUR_TOLERANCE = 1.1; // paths this much longer than the straight line are not worth following
+    const int BUCKETS = 64; // more than the largest seed cost plus one step, so pending costs never wrap onto each other
+}
+
+const int FlowField::UNREACHABLE; // passed by reference to fill, so it needs a definition
+
+FlowField::FlowField()
+    : m_cost(CELLS_PER_SIDE * CELLS_PER_SIDE, UNREACHABLE), m_passable(CELLS_PER_SIDE * CELLS_PER_SIDE, true), m_open(BUCKETS)
+{
+    m_targetX = VIEW_WIDTH / 2;
+    m_targetY = VIEW_HEIGHT / 2;
+
+    // a bucket holds part of the search front at a time, which is never much longer than a few sides of the grid
+    for (auto &bucket : m_open)
+        bucket.reserve(4 * CELLS_PER_SIDE);
+}
+
+void FlowField::setObstacles(const ObstacleMap &obstacles) {
+    // a cell can be crossed unless most of it is blocked; smaller gaps are left to the exact movement test
+    const double offset = CELL_SIZE / 4.0;
+    for (int cy = 0; cy < CELLS_PER_SIDE; cy++) {
+        for (int cx = 0; cx < CELLS_PER_SIDE; cx++) {
+            int blocked = 0;
+            for (int sy = -1; sy <= 1; sy += 2)
+                for (int sx = -1; sx <= 1; sx += 2)
+                    if (obstacles.classify(cellCenter(cx) + sx * offset, cellCenter(cy) + sy * offset) == ObstacleMap::BLOCKED)
+                        blocked++;
+            m_passable[cy * CELLS_PER_SIDE + cx] = (blocked < 3);
+        }
+    }
+}
+
+void FlowField::build(double targetX, double targetY) {
+    m_targetX = targetX;
+    m_targetY = targetY;
+    fill(m_cost.begin(), m_cost.end(), UNREACHABLE);
+
+    // the target sits on the rim, outside the open part of the dish, so the search starts from the cells around it
+    int pending = 0;
+    for (int cy = cellCoordinate(max(targetY - SEED_RADIUS, 0.0)); cy <= min(cellCoordinate(targetY + SEED_RADIUS), CELLS_PER_SIDE - 1); cy++) {
+        for (int cx = cellCoordinate(max(targetX - SEED_RADIUS, 0.0)); cx <= min(cellCoordinate(targetX + SEED_RADIUS), CELLS_PER_SIDE - 1); cx++) {
+            int cell = cy * CELLS_PER_SIDE + cx;
+            double d = distance(cellCenter(cx), cellCenter(cy), targetX, targetY);
+            if (m_passable[cell] && d <= SEED_RADIUS) {
+                m_cost[cell] = (int) (d * STRAIGHT_COST / CELL_SIZE);
+                m_open[m_cost[cell] % BUCKETS].push_back(cell);
+                pending++;
+            }
+        }
+    }
+
+    // Dijkstra over the 8-connected cell graph; the step costs are small integers, so a ring of buckets indexed by
+    // cost replaces the priority queue and every cell is expanded in constant time
+    for (int cost = 0; pending > 0; cost++) {
+        vector<int> &bucket = m_open[cost % BUCKETS];
+        for (size_t i = 0; i < bucket.size(); i++) {
+            int cell = bucket[i];
+            if (m_cost[cell] != cost)
+                continue; // a shorter path to this cell was already expanded
+            int cx = cell % CELLS_PER_SIDE, cy = cell / CELLS_PER_SIDE;
+            for (int dy = -1; dy <= 1; dy++) {
+                for (int dx = -1; dx <= 1; dx++) {
+                    int nx = cx + dx, ny = cy + dy;
+                    if ((dx == 0 && dy == 0) || nx < 0 || ny < 0 || nx >= CELLS_PER_SIDE || ny >= CELLS_PER_SIDE)
+                        continue;
+                    int next = ny * CELLS_PER_SIDE + nx;
+                    if (!m_passable[next])
+                        continue;
+
+                    // diagonal steps may not cut the corner of a blocked cell
+                    bool diagonal = (dx != 0 && dy != 0);
+                    if (diagonal && (!m_passable[cy * CELLS_PER_SIDE + nx] || !m_passable[ny * CELLS_PER_SIDE + cx]))
+                        continue;
+                    int nextCost = cost + (diagonal ? DIAGONAL_COST : STRAIGHT_COST);
+                    if (m_cost[next] == UNREACHABLE || nextCost < m_cost[next]) {
+                        m_cost[next] = nextCost;
+                        m_open[nextCost % BUCKETS].push_back(next);
+                        pending++;
+                    }
+                }
+            }
+        }
+        pending -= (int) bucket.size();
+        bucket.clear();
+    }
+}
+
+bool FlowField::direction(double x, double y, Direction &result) const {
+    if (x < 0 || y < 0 || x >= VIEW_WIDTH || y >= VIEW_HEIGHT)
+        return false;
+    int cx = cellCoordinate(x), cy = cellCoordinate(y);
+    int cost = m_cost[cy * CELLS_PER_SIDE + cx];
+    if (cost == UNREACHABLE)
+        return false;
+
+    // when nothing stands in the way the shortest path is the straight line, which the cells can only approximate
+    double straight = distance(x, y, m_targetX, m_targetY) * STRAIGHT_COST / CELL_SIZE;
+    if (cost <= straight * DETOUR_TOLERANCE + STRAIGHT_COST) {
+        result = angleBetweenPositions(m_targetX, m_targetY, x, y);
+        return true;
+    }
+
+    // otherwise head for the neighbouring cell that is closest to the target along the path
+    int bestCost = cost, bestX = cx, bestY = cy;
+    for (int dy = -1; dy <= 1; dy++) {
+        for (int dx = -1; dx <= 1; dx++) {
+            int nx = cx + dx, ny = cy + dy;
+            if (nx < 0 || ny < 0 || nx >= CELLS_PER_SIDE || ny >= CELLS_PER_SIDE)
+                continue;
+            int nextCost = m_cost[ny * CELLS_PER_SIDE + nx];
+            if (nextCost != UNREACHABLE && nextCost < bestCost) {
+                bestCost = nextCost;
+                bestX = nx;
+                bestY = ny;
+            }
+        }
+    }
+    if (bestX == cx && bestY == cy)
+        result = angleBetweenPositions(m_targetX, m_targetY, x, y);
+    else
+        result = angleBetweenPositions(cellCenter(bestX), cellCenter(bestY), x, y);
+    return true;
+}
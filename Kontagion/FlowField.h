@@ -0,0 +1,39 @@
+#ifndef FLOWFIELD_H_
+#define FLOWFIELD_H_
+
+#include "GameConstants.h"
+#include "ObstacleMap.h"
+#include <vector>
+
+using Direction = int;
+
+// Dish-wide navigation field towards a single target (Socrates). The dish is split into small cells and every cell
+// stores the length of the shortest path around the dirt piles to the target, so a pursuer only has to look at its
+// own cell and its neighbours to know which way to go.
+class FlowField {
+public:
+    FlowField();
+    void setObstacles(const ObstacleMap& obstacles); // decides which cells can be crossed, call again when dirt changes
+    void build(double targetX, double targetY); // recomputes every cell's path length to the target
+
+    // heading from (x, y) along the shortest path to the target; false if the target cannot be reached from there
+    bool direction(double x, double y, Direction &result) const;
+
+private:
+    static const int CELL_SIZE = SPRITE_WIDTH; // side of one cell in pixels
+    static const int CELLS_PER_SIDE = VIEW_WIDTH / CELL_SIZE;
+    static const int STRAIGHT_COST = 10; // path cost of moving to a side neighbour
+    static const int DIAGONAL_COST = 14; // path cost of moving to a corner neighbour
+    static const int UNREACHABLE = -1;
+
+    std::vector<int> m_cost; // path cost from each cell to the target, or UNREACHABLE
+    std::vector<bool> m_passable; // whether a pursuer can cross each cell
+    std::vector<std::vector<int>> m_open; // cells still to be expanded, bucketed by path cost modulo the bucket count
+    double m_targetX;
+    double m_targetY;
+
+    static int cellCoordinate(double v) { return (int) (v / CELL_SIZE); }
+    static double cellCenter(int c) { return c * CELL_SIZE + CELL_SIZE / 2.0; }
+};
+
+#endif // FLOWFIELD_H_
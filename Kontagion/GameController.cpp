@@ -51,7 +51,7 @@ struct SpriteInfo
 };
 
 static void drawPrompt(string mainMessage, string secondMessage);
-static void drawScoreAndLives(string);
+static void drawScoreAndLives(string, RandomEngine&);
 
 enum GameController::GameControllerState : int {
     welcome, init, makemove, animate, contgame, finishedlevel, cleanup,
@@ -132,7 +132,7 @@ static void timerFuncCallback(int)
 
 void GameController::run(int argc, char* argv[], GameWorld* gw, string windowTitle)
 {
-    gw->setController(this);
+    gw->setFrontend(this);
     m_gw = gw;
     setGameState(welcome);
     m_lastKeyHit = INVALID_KEY;
@@ -333,14 +333,14 @@ void GameController::displayGamePlay()
 #pragma GCC diagnostic pop
 #endif
 
-    GraphObject::drawAllObjects(
+    m_gw->renderList().drawAll(
         [=](int imageID, int animationNumber, double x, double y, int angle, double size)
         {
             int frame = animationNumber % m_spriteManager.getNumFrames(imageID);
             m_spriteManager.plotSprite(imageID, frame, x, y, angle, size);
         });
 
-    drawScoreAndLives(m_gameStatText);
+    drawScoreAndLives(m_gameStatText, m_statusFlicker);
 
     SpriteManager::drawCircle(VIEW_WIDTH / 2, VIEW_HEIGHT / 2, VIEW_WIDTH / 2 + SPRITE_WIDTH, 100);
 
@@ -402,14 +402,14 @@ static void drawPrompt(string mainMessage, string secondMessage)
     glutSwapBuffers();
 }
 
-static void drawScoreAndLives(string gameStatText)
+static void drawScoreAndLives(string gameStatText, RandomEngine& random)
 {
     static int RATE = 1;
     static GLfloat rgb[3] =
         { static_cast<GLfloat>(.6), static_cast<GLfloat>(.6), static_cast<GLfloat>(.6) };
     for (int k = 0; k < 3; k++)
     {
-        double strength = rgb[k] + randInt(-RATE, RATE) / 100.0;
+        double strength = rgb[k] + random.randInt(-RATE, RATE) / 100.0;
         if (strength < .6)
             strength = .6;
         else if (strength > 1.0)
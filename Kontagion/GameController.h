@@ -1,7 +1,9 @@
 #ifndef GAMECONTROLLER_H_
 #define GAMECONTROLLER_H_
 
+#include "GameFrontend.h"
 #include "SpriteManager.h"
+#include "RandomEngine.h"
 #include <string>
 #include <map>
 #include <iostream>
@@ -12,12 +14,12 @@ const int INVALID_KEY = 0;
 class GraphObject;
 class GameWorld;
 
-class GameController
+class GameController : public GameFrontend
 {
   public:
     void run(int argc, char* argv[], GameWorld* gw, std::string windowTitle);
 
-    bool getLastKey(int& value)
+    virtual bool getLastKey(int& value)
     {
         if (m_lastKeyHit != INVALID_KEY)
         {
@@ -28,9 +30,9 @@ class GameController
         return false;
     }
 
-    void playSound(int soundID);
+    virtual void playSound(int soundID);
 
-    void setGameStatText(std::string text)
+    virtual void setGameStatText(const std::string& text)
     {
         m_gameStatText = text;
     }
@@ -41,7 +43,7 @@ class GameController
     void keyboardEvent(unsigned char key, int x, int y);
     void specialKeyboardEvent(int key, int x, int y);
 
-    void quitGame();
+    virtual void quitGame();
 
       // Meyers singleton pattern
     static GameController& getInstance()
@@ -68,6 +70,7 @@ private:
     SoundMapType  m_soundMap;
     bool          m_playerWon;
     SpriteManager m_spriteManager;
+    RandomEngine  m_statusFlicker{1}; // kept apart from the world's generator, so how often the screen is redrawn cannot change the game
 
     void setGameState(GameControllerState s);
     void setGameStateAfterPrompting(GameControllerState s,
@@ -0,0 +1,20 @@
+#ifndef GAMEFRONTEND_H_
+#define GAMEFRONTEND_H_
+
+#include <string>
+
+// What a GameWorld needs from whatever is running it: keys pressed by the player, and somewhere to send sounds and
+// the status line. The GLUT GameController is one frontend; ScriptedFrontend runs the game without any window, so
+// the simulation itself does not depend on GL or GLUT.
+class GameFrontend
+{
+public:
+    virtual ~GameFrontend() = default;
+
+    virtual bool getLastKey(int& value) = 0; // false if no key was pressed since the last call
+    virtual void playSound(int soundID) = 0;
+    virtual void setGameStatText(const std::string& text) = 0;
+    virtual void quitGame() = 0;
+};
+
+#endif // GAMEFRONTEND_H_
@@ -1,27 +1,34 @@
 #include "GameWorld.h"
-#include "GameController.h"
+#include "GameFrontend.h"
 #include <string>
 #include <cstdlib>
 using namespace std;
 
+  // A world without a frontend runs silently and never sees a key
+
 bool GameWorld::getKey(int& value)
 {
-    bool gotKey = m_controller->getLastKey(value);
+    if (m_frontend == nullptr)
+        return false;
+
+    bool gotKey = m_frontend->getLastKey(value);
 
     if (gotKey)
     {
         if (value == 'q'  ||  value == '\x03')  // CTRL-C
-            m_controller->quitGame();
+            m_frontend->quitGame();
     }
     return gotKey;
 }
 
 void GameWorld::playSound(int soundID)
 {
-    m_controller->playSound(soundID);
+    if (m_frontend != nullptr)
+        m_frontend->playSound(soundID);
 }
 
-void GameWorld::setGameStatText(string text)
+void GameWorld::setGameStatText(const string& text)
 {
-    m_controller->setGameStatText(text);
+    if (m_frontend != nullptr)
+        m_frontend->setGameStatText(text);
 }
@@ -2,19 +2,22 @@
 #define GAMEWORLD_H_
 
 #include "GameConstants.h"
+#include "RandomEngine.h"
+#include "GraphObject.h"
 #include <string>
+#include <cstdint>
 
 const int START_PLAYER_LIVES = 3;
 
-class GameController;
+class GameFrontend;
 
 class GameWorld
 {
 public:
 
-    GameWorld(std::string assetPath)
+    GameWorld(std::string assetPath, uint64_t seed)
      : m_lives(START_PLAYER_LIVES), m_score(0), m_level(1),
-       m_controller(nullptr), m_assetPath(assetPath)
+       m_frontend(nullptr), m_assetPath(assetPath), m_random(seed)
     {
     }
 
@@ -26,7 +29,7 @@ public:
     virtual int move() = 0;
     virtual void cleanUp() = 0;
 
-    void setGameStatText(std::string text);
+    void setGameStatText(const std::string& text);
 
     bool getKey(int& value);
     void playSound(int soundID);
@@ -65,6 +68,25 @@ public:
     {
         return m_assetPath;
     }
+
+      // What is drawn for this world; each world has its own, so several can exist at once
+
+    RenderList& renderList()
+    {
+        return m_renderList;
+    }
+
+      // Every random decision of the game comes from this world's own generator
+
+    RandomEngine& rng()
+    {
+        return m_random;
+    }
+
+    int randInt(int min, int max)
+    {
+        return m_random.randInt(min, max);
+    }
     
       // The following should be used by only the framework, not the student
 
@@ -78,17 +100,19 @@ public:
         ++m_level;
     }
    
-    void setController(GameController* controller)
+    void setFrontend(GameFrontend* frontend)
     {
-        m_controller = controller;
+        m_frontend = frontend;
     }
     
 private:
     int m_lives;
     int m_score;
     int m_level;
-    GameController* m_controller;
+    GameFrontend*   m_frontend;
     std::string     m_assetPath;
+    RandomEngine    m_random;
+    RenderList      m_renderList;
 };
 
 #endif // GAMEWORLD_H_
@@ -1,16 +1,48 @@
 #ifndef GRAPHOBJ_H_
 #define GRAPHOBJ_H_
 
-#include "SpriteManager.h"
 #include "GameConstants.h"
+#include "TrigTables.h"
 
-#include <set>
 #include <cmath>
 
 const int ANIMATION_POSITIONS_PER_TICK = 1;
 
 using Direction = int;
 
+class GraphObject;
+
+  // The objects drawn for one world, in a list per depth. Each world has its own, so that worlds can exist side by
+  // side; the links live in the objects themselves, so nothing is allocated when objects come and go.
+class RenderList
+{
+  public:
+
+    template<typename Func>
+    void drawAll(Func plotFunc);
+
+      // Forget every object at once without destroying them, for when a whole level is dropped from its arena
+    void forgetAll()
+    {
+        for (int depth = 0; depth < NUM_DEPTHS; depth++)
+            m_first[depth] = nullptr;
+    }
+
+  private:
+    friend class GraphObject;
+
+    static const int NUM_DEPTHS = 4;
+    GraphObject* m_first[NUM_DEPTHS] = {};
+
+    GraphObject*& first(int depth)
+    {
+        if (depth < NUM_DEPTHS)
+            return m_first[depth];
+        else
+            return m_first[0];
+    }
+};
+
 class GraphObject
 {
   public:
@@ -22,17 +54,23 @@ class GraphObject
 
     GraphObject(int imageID, double startX, double startY, Direction dir = 0, int depth = 0, double size = 1.0)
      : m_imageID(imageID), m_x(startX), m_y(startY), m_destX(startX), m_destY(startY),
-       m_animationNumber(0), m_direction(dir), m_depth(depth), m_size(size)
+       m_animationNumber(0), m_direction(dir), m_depth(depth), m_size(size), m_visible(true),
+       m_list(nullptr), m_previousAtDepth(nullptr), m_nextAtDepth(nullptr)
     {
         if (m_size <= 0)
             m_size = 1;
-
-        getGraphObjects(m_depth).insert(this);
     }
 
     virtual ~GraphObject()
     {
-        getGraphObjects(m_depth).erase(this);
+        if (m_list == nullptr)
+            return;
+        if (m_previousAtDepth != nullptr)
+            m_previousAtDepth->m_nextAtDepth = m_nextAtDepth;
+        else
+            m_list->first(m_depth) = m_nextAtDepth;
+        if (m_nextAtDepth != nullptr)
+            m_nextAtDepth->m_previousAtDepth = m_previousAtDepth;
     }
 
     double getX() const
@@ -56,9 +94,8 @@ class GraphObject
 
     virtual void moveAngle(Direction angle, int units = 1)
     {
-    	const double PI = 4 * atan(1);
-    	double newX = (getX() + units * cos(angle*1.0 / 360 * 2 * PI));
-    	double newY = (getY() + units * sin(angle*1.0 / 360 * 2 * PI));
+    	double newX = (getX() + units * cosDegrees(angle));
+    	double newY = (getY() + units * sinDegrees(angle));
 
     	moveTo(newX, newY);
     	increaseAnimationNumber();
@@ -66,9 +103,8 @@ class GraphObject
 
     virtual void getPositionInThisDirection(Direction angle, int units, double &dx, double &dy)
     {
-    	const double PI = 4 * atan(1);
-    	dx = (getX() + units * cos(angle*1.0 / 360 * 2 * PI));
-    	dy = (getY() + units * sin(angle*1.0 / 360 * 2 * PI));
+    	dx = (getX() + units * cosDegrees(angle));
+    	dy = (getY() + units * sinDegrees(angle));
     }
 
     void moveForward(int units = 1)
@@ -99,6 +135,16 @@ class GraphObject
         return m_size;
     }
 
+    void setVisible(bool visible)
+    {
+        m_visible = visible;
+    }
+
+    bool isVisible() const
+    {
+        return m_visible;
+    }
+
       // The following should be used by only the framework, not the student
 
     void increaseAnimationNumber()
@@ -106,17 +152,16 @@ class GraphObject
         m_animationNumber++;
     }
 
-    template<typename Func>
-    static void drawAllObjects(Func plotFunc)
+      // Objects are only drawn once they have been added to the render list of their world, which is done once
+    void addTo(RenderList& list)
     {
-        for (int depth = NUM_DEPTHS - 1; depth >= 0; depth--)
-        {
-            for (GraphObject* go : getGraphObjects(depth))
-            {
-                go->animate();
-                plotFunc(go->m_imageID, go->m_animationNumber, go->m_x, go->m_y, go->m_direction, go->m_size);
-            }
-        }
+        GraphObject*& first = list.first(m_depth);
+        m_list = &list;
+        m_previousAtDepth = nullptr;
+        m_nextAtDepth = first;
+        if (first != nullptr)
+            first->m_previousAtDepth = this;
+        first = this;
     }
 
       // Prevent copying or assigning GraphObjects
@@ -124,8 +169,8 @@ class GraphObject
     GraphObject& operator=(const GraphObject&) = delete;
 
   private:
+    friend class RenderList;
 
-    static const int NUM_DEPTHS = 4;
     int     m_imageID;
     double  m_x;
     double  m_y;
@@ -135,6 +180,10 @@ class GraphObject
     Direction   m_direction;
     int     m_depth;
     double  m_size;
+    bool    m_visible;
+    RenderList*  m_list;
+    GraphObject* m_previousAtDepth;
+    GraphObject* m_nextAtDepth;
 
     void animate()
     {
@@ -154,15 +203,21 @@ class GraphObject
         else
             from = to;
     }
+};
 
-    static std::set<GraphObject*>& getGraphObjects(int depth)
+template<typename Func>
+void RenderList::drawAll(Func plotFunc)
+{
+    for (int depth = NUM_DEPTHS - 1; depth >= 0; depth--)
     {
-        static std::set<GraphObject*> graphObjects[NUM_DEPTHS];
-        if (depth < NUM_DEPTHS)
-            return graphObjects[depth];
-        else
-            return graphObjects[0];     // empty;
+        for (GraphObject* go = m_first[depth]; go != nullptr; go = go->m_nextAtDepth)
+        {
+            if (!go->m_visible)
+                continue;
+            go->animate();
+            plotFunc(go->m_imageID, go->m_animationNumber, go->m_x, go->m_y, go->m_direction, go->m_size);
+        }
     }
-};
+}
 
 #endif // GRAPHOBJ_H_
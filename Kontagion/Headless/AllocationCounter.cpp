@@ -0,0 +1,36 @@
+#include "AllocationCounter.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+using namespace std;
+
+namespace {
+    atomic<bool> counting(false);
+    atomic<long long> allocations(0);
+}
+
+void AllocationCounter::setCounting(bool on) {
+    counting.store(on, memory_order_relaxed);
+}
+
+long long AllocationCounter::count() {
+    return allocations.load(memory_order_relaxed);
+}
+
+// the array and nothrow forms call these, and nothing in the game asks for more than the usual alignment
+void* operator new(size_t size) {
+    if (counting.load(memory_order_relaxed))
+        allocations.fetch_add(1, memory_order_relaxed);
+    if (void* p = malloc(size > 0 ? size : 1))
+        return p;
+    throw bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+    free(p);
+}
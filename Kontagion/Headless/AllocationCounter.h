@@ -0,0 +1,12 @@
+#ifndef ALLOCATIONCOUNTER_H_
+#define ALLOCATIONCOUNTER_H_
+
+// Counts the allocations made through operator new, on any thread, while counting is switched on. Linking this in
+// replaces the global operator new and delete, so the allocations of the standard containers are counted too.
+class AllocationCounter {
+public:
+    static void setCounting(bool on);
+    static long long count(); // allocations counted so far
+};
+
+#endif // ALLOCATIONCOUNTER_H_
@@ -0,0 +1,273 @@
+// Batch runner for balancing the levels: plays many seeded games at once, spread over a pool of threads, with a
+// simple scripted Socrates, and writes statistics for each level to a CSV file.
+//
+//   kontagion-batch [--games N] [--seed S] [--threads N] [--max-level N] [--max-ticks N] [--csv FILE]
+//                   [--games-csv FILE]
+//
+// Game g is played from seed S + g, so everything but the times comes out the same for any number of threads. A
+// game ends when Socrates runs out of lives, once level N has been cleared (10 unless given), or after N ticks
+// (200000 unless given). The per-level statistics go to FILE (levels.csv unless given); --games-csv also writes
+// one row for every level of every game.
+
+#include "StudentWorld.h"
+#include "GameFrontend.h"
+#include "WorkerPool.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+using namespace std;
+
+namespace {
+    const double SPRAY_REACH = 112 + SPRITE_WIDTH; // a spray flies 112 pixels and hits what it passes within a sprite
+    const double FLAME_REACH = 2 * SPRITE_RADIUS + FLAME_TRAVEL_DISTANCE + SPRITE_WIDTH; // the same for the flames
+    const int CROWD = 3; // bacteria within reach of the flames that are worth a flamethrower charge
+
+    // Socrates walks round the rim until he faces the closest bacterium, sprays it once it is within reach, and
+    // uses the flamethrower when he is crowded; he stands still, which recharges the sprays, when there is nothing
+    // to do
+    class Policy : public GameFrontend
+    {
+    public:
+        explicit Policy(StudentWorld* world) { m_world = world; }
+
+        virtual bool getLastKey(int& value);
+        virtual void playSound(int soundID) {}
+        virtual void setGameStatText(const std::string& text) {}
+        virtual void quitGame() {}
+
+    private:
+        StudentWorld* m_world;
+    };
+
+    bool Policy::getLastKey(int &value) {
+        const Socrates* socrates = m_world->player();
+        BacteriaStore &bacteria = m_world->bacteria();
+        int target = -1, crowd = 0;
+        double targetSquared = 0;
+        for (int i = 0; i < bacteria.size(); i++) {
+            if (bacteria.hitPoints(i) <= 0)
+                continue;
+            double squared = distanceSquared(bacteria.x(i), bacteria.y(i), socrates->getX(), socrates->getY());
+            if (squared <= FLAME_REACH * FLAME_REACH)
+                crowd++;
+            if (target < 0 || squared < targetSquared) {
+                target = i;
+                targetSquared = squared;
+            }
+        }
+        if (target < 0)
+            return false;
+        if (crowd >= CROWD && socrates->getFlamesLeft() > 0) {
+            value = KEY_PRESS_ENTER;
+            return true;
+        }
+
+        // Socrates faces the middle of the dish, so he faces the target from the point of the rim in line with it
+        int position = socrates->getDirection() - 180;
+        int wanted = angleBetweenPositions(bacteria.x(target), bacteria.y(target), VIEW_WIDTH / 2, VIEW_HEIGHT / 2);
+        int turn = normalizeDegrees(wanted - position);
+        if (turn > 180)
+            turn -= 360;
+        if (turn >= 5)
+            value = KEY_PRESS_LEFT;
+        else if (turn <= -5)
+            value = KEY_PRESS_RIGHT;
+        else if (targetSquared <= SPRAY_REACH * SPRAY_REACH && socrates->getSpraysLeft() > 0)
+            value = KEY_PRESS_SPACE;
+        else
+            return false;
+        return true;
+    }
+
+    struct LevelResult {
+        int level;
+        bool cleared;
+        long long ticks; // ticks played on the level, counting those of lives lost on it
+        int deaths;
+        int peakBacteria; // most bacteria alive at the end of a tick
+        int score; // when the level was cleared or the game ended
+        double seconds;
+    };
+
+    struct GameResult {
+        uint64_t seed;
+        vector<LevelResult> levels;
+    };
+
+    GameResult playGame(uint64_t seed, int maxLevel, long long maxTicks) {
+        GameResult game{seed, {}};
+        StudentWorld world("", seed);
+        Policy policy(&world);
+        world.setFrontend(&policy);
+
+        long long ticks = 0;
+        int status = world.init();
+        bool playing = (status != GWSTATUS_LEVEL_ERROR);
+        LevelResult current{world.getLevel(), false, 0, 0, 0, 0, 0};
+        auto levelStart = chrono::steady_clock::now();
+        auto endLevel = [&](bool cleared) {
+            current.cleared = cleared;
+            current.score = world.getScore();
+            current.seconds = chrono::duration<double>(chrono::steady_clock::now() - levelStart).count();
+            game.levels.push_back(current);
+        };
+
+        while (playing && ticks < maxTicks) {
+            status = world.move();
+            ticks++;
+            current.ticks++;
+            current.peakBacteria = max(current.peakBacteria, world.bacteria().size());
+            if (status == GWSTATUS_FINISHED_LEVEL) {
+                endLevel(true);
+                world.cleanUp();
+                if (world.getLevel() >= maxLevel)
+                    return game;
+                world.advanceToNextLevel();
+                status = world.init();
+                playing = (status != GWSTATUS_LEVEL_ERROR);
+                current = LevelResult{world.getLevel(), false, 0, 0, 0, 0, 0};
+                levelStart = chrono::steady_clock::now();
+            }
+            else if (status == GWSTATUS_PLAYER_DIED) {
+                current.deaths++;
+                world.cleanUp();
+                if (world.isGameOver()) {
+                    endLevel(false);
+                    return game;
+                }
+                status = world.init();
+                playing = (status != GWSTATUS_LEVEL_ERROR);
+            }
+        }
+
+        // out of ticks, or a level that could not be laid out
+        endLevel(false);
+        world.cleanUp();
+        return game;
+    }
+
+    void usage() {
+        fprintf(stderr, "usage: kontagion-batch [--games N] [--seed S] [--threads N] [--max-level N] [--max-ticks N] [--csv FILE] [--games-csv FILE]\n");
+        exit(2);
+    }
+
+    long long numberArgument(int argc, char* argv[], int &i) {
+        if (i + 1 >= argc)
+            usage();
+        char* end;
+        long long value = strtoll(argv[++i], &end, 10);
+        if (*end != '\0' || value < 0)
+            usage();
+        return value;
+    }
+
+    bool writeLevels(const string &fileName, const vector<GameResult> &games) {
+        FILE* f = fopen(fileName.c_str(), "w");
+        if (f == nullptr)
+            return false;
+        fprintf(f, "level,games,cleared,clear_rate,mean_ticks_to_clear,mean_peak_bacteria,max_peak_bacteria,mean_deaths,mean_score,mean_seconds\n");
+        int levels = 0;
+        for (auto &g : games)
+            for (auto &l : g.levels)
+                levels = max(levels, l.level);
+        for (int level = 1; level <= levels; level++) {
+            long long played = 0, cleared = 0, clearTicks = 0, peakTotal = 0, deaths = 0, score = 0;
+            int peakMax = 0;
+            double seconds = 0;
+            for (auto &g : games) {
+                for (auto &l : g.levels) {
+                    if (l.level != level)
+                        continue;
+                    played++;
+                    if (l.cleared) {
+                        cleared++;
+                        clearTicks += l.ticks;
+                    }
+                    peakTotal += l.peakBacteria;
+                    peakMax = max(peakMax, l.peakBacteria);
+                    deaths += l.deaths;
+                    score += l.score;
+                    seconds += l.seconds;
+                }
+            }
+            if (played == 0)
+                continue;
+            fprintf(f, "%d,%lld,%lld,%.4f,%.1f,%.2f,%d,%.3f,%.1f,%.6f\n", level, played, cleared, (double) cleared / played,
+                    (cleared > 0 ? (double) clearTicks / cleared : 0.0), (double) peakTotal / played, peakMax,
+                    (double) deaths / played, (double) score / played, seconds / played);
+        }
+        return fclose(f) == 0;
+    }
+
+    bool writeGames(const string &fileName, const vector<GameResult> &games) {
+        FILE* f = fopen(fileName.c_str(), "w");
+        if (f == nullptr)
+            return false;
+        fprintf(f, "seed,level,cleared,ticks,deaths,peak_bacteria,score,seconds\n");
+        for (auto &g : games)
+            for (auto &l : g.levels)
+                fprintf(f, "%llu,%d,%d,%lld,%d,%d,%d,%.6f\n", (unsigned long long) g.seed, l.level, (int) l.cleared, l.ticks,
+                        l.deaths, l.peakBacteria, l.score, l.seconds);
+        return fclose(f) == 0;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    long long games = 1000, maxLevel = 10, maxTicks = 200000;
+    uint64_t seed = 1;
+    int threads = max(1, (int) thread::hardware_concurrency());
+    string csvFile = "levels.csv", gamesFile;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--games") == 0)
+            games = numberArgument(argc, argv, i);
+        else if (strcmp(argv[i], "--seed") == 0)
+            seed = (uint64_t) numberArgument(argc, argv, i);
+        else if (strcmp(argv[i], "--threads") == 0)
+            threads = (int) min(numberArgument(argc, argv, i), 1024LL);
+        else if (strcmp(argv[i], "--max-level") == 0)
+            maxLevel = numberArgument(argc, argv, i);
+        else if (strcmp(argv[i], "--max-ticks") == 0)
+            maxTicks = numberArgument(argc, argv, i);
+        else if (strcmp(argv[i], "--csv") == 0 && i + 1 < argc)
+            csvFile = argv[++i];
+        else if (strcmp(argv[i], "--games-csv") == 0 && i + 1 < argc)
+            gamesFile = argv[++i];
+        else
+            usage();
+    }
+    if (threads < 1 || games > INT32_MAX || maxLevel < 1)
+        usage();
+
+    // one game per block, so that a thread that drew short games goes on to take more
+    vector<GameResult> results(games);
+    WorkerPool workers(threads);
+    auto start = chrono::steady_clock::now();
+    workers.parallelFor((int) games, 1, [&](int begin, int end, int) {
+        for (int g = begin; g < end; g++)
+            results[g] = playGame(seed + g, (int) maxLevel, maxTicks);
+    });
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    long long ticks = 0;
+    for (auto &g : results)
+        for (auto &l : g.levels)
+            ticks += l.ticks;
+    printf("games %lld  threads %d  %.3f s  %.1f games/s  %.0f ticks/s\n", games, threads, seconds, games / seconds, ticks / seconds);
+
+    if (!writeLevels(csvFile, results)) {
+        fprintf(stderr, "kontagion-batch: cannot write %s\n", csvFile.c_str());
+        return 1;
+    }
+    if (!gamesFile.empty() && !writeGames(gamesFile, results)) {
+        fprintf(stderr, "kontagion-batch: cannot write %s\n", gamesFile.c_str());
+        return 1;
+    }
+    return 0;
+}
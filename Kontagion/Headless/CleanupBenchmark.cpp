@@ -0,0 +1,126 @@
+// Benchmark for removing dead actors at the end of a tick: how much longer a tick takes with k actors dying in it
+// than the same tick with none dying, for a range of k.
+//
+//   kontagion-bench-cleanup [--ticks N] [--seed S]
+//
+// A level 1 world gets about a thousand extra pieces of food, laid out in the corners of the window, outside the
+// dish, where no bacterium can reach them. Ticks in which k of them are killed, as if eaten, alternate with ticks in
+// which nothing is killed; the difference between the median times of the two is what cleaning up after the k
+// deaths costs. A new world is set up whenever the food runs out, until each k has been measured over N ticks of
+// each kind (200 unless given).
+
+#include "StudentWorld.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+using namespace std;
+
+namespace {
+    const int DEATHS[] = {0, 1, 2, 4, 8, 16, 32, 64}; // deaths per tick measured
+    const int SPACING = 2; // pixels between neighbouring pieces of food
+    const double OUT_OF_REACH = VIEW_RADIUS + 12; // further from the middle than a bacterium can eat
+
+    struct Result {
+        double withDeaths; // median tick time in microseconds
+        double without;
+    };
+
+    double median(vector<double> &times) {
+        sort(times.begin(), times.end());
+        return (times.empty() ? 0.0 : times[times.size() / 2]);
+    }
+
+    double timeTick(StudentWorld &world, int &status) {
+        auto start = chrono::steady_clock::now();
+        status = world.move();
+        return chrono::duration<double, micro>(chrono::steady_clock::now() - start).count();
+    }
+
+    // the extra food, in the random order it is to be killed in, so that deaths are spread over the indexes
+    vector<Actor*> addFood(StudentWorld &world, int &status) {
+        vector<Location> spots;
+        for (int y = 0; y < VIEW_HEIGHT; y += SPACING)
+            for (int x = 0; x < VIEW_WIDTH; x += SPACING)
+                if (distanceSquared(x, y, VIEW_WIDTH / 2, VIEW_HEIGHT / 2) > OUT_OF_REACH * OUT_OF_REACH)
+                    spots.push_back(Location(x, y));
+        for (auto &s : spots)
+            world.addFood(s.first, s.second);
+        status = world.move(); // the food joins the world at the end of the tick
+
+        vector<Actor*> pieces;
+        for (auto &s : spots)
+            if (Actor* a = world.foodAt(s.first, s.second))
+                pieces.push_back(a);
+        for (int i = (int) pieces.size() - 1; i > 0; i--)
+            swap(pieces[i], pieces[world.randInt(0, i)]);
+        return pieces;
+    }
+
+    Result measure(int deaths, int ticks, uint64_t seed) {
+        vector<double> withDeaths, without;
+        while ((int) withDeaths.size() < ticks) {
+            StudentWorld world("", seed++);
+            int status = world.init();
+            vector<Actor*> pieces;
+            if (status == GWSTATUS_CONTINUE_GAME)
+                pieces = addFood(world, status);
+            size_t next = 0;
+            while ((int) withDeaths.size() < ticks && status == GWSTATUS_CONTINUE_GAME && next + deaths <= pieces.size()) {
+                for (int d = 0; d < deaths; d++)
+                    pieces[next++]->setDead();
+                withDeaths.push_back(timeTick(world, status));
+                if (status == GWSTATUS_CONTINUE_GAME)
+                    without.push_back(timeTick(world, status));
+            }
+            world.cleanUp();
+            if (next == 0 && deaths > 0)
+                break; // the world cannot be set up for this many deaths, so this would never end
+        }
+        return Result{median(withDeaths), median(without)};
+    }
+
+    void usage() {
+        fprintf(stderr, "usage: kontagion-bench-cleanup [--ticks N] [--seed S]\n");
+        exit(2);
+    }
+
+    long long numberArgument(int argc, char* argv[], int &i) {
+        if (i + 1 >= argc)
+            usage();
+        char* end;
+        long long value = strtoll(argv[++i], &end, 10);
+        if (*end != '\0' || value < 0)
+            usage();
+        return value;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    long long ticks = 200;
+    uint64_t seed = 1;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--ticks") == 0)
+            ticks = numberArgument(argc, argv, i);
+        else if (strcmp(argv[i], "--seed") == 0)
+            seed = (uint64_t) numberArgument(argc, argv, i);
+        else
+            usage();
+    }
+    if (ticks < 1)
+        usage();
+
+    printf("deaths/tick  tick (us)  no deaths (us)  cleanup (us)  per death (ns)\n");
+    for (int deaths : DEATHS) {
+        Result r = measure(deaths, (int) ticks, seed);
+        double cleanup = r.withDeaths - r.without;
+        printf("%11d  %9.2f  %14.2f  %12.2f  %14s\n", deaths, r.withDeaths, r.without, cleanup,
+               (deaths > 0 ? to_string((int) (cleanup * 1000 / deaths)).c_str() : "-"));
+    }
+    return 0;
+}
@@ -0,0 +1,170 @@
+// Benchmark for running the actors of a tick: the UpdateScheduler's buckets, each run as a batch through direct
+// calls, against the interleaved dispatch it replaced, which called the virtual doSomething of every actor in the
+// order they were spawned, whether or not it had anything to do.
+//
+//   kontagion-bench-dispatch [--rounds N] [--actors N] [--seed S]
+//
+// Each round sets up two copies of a level 1 world from the same seed and adds the same N actors to both (400
+// unless given): sprays and flame bursts flying in random directions, mixed at random with dirt, food, goodies and
+// fungi, which do nothing when they are run. One copy runs them through an UpdateScheduler and the other through
+// the virtual calls, for a few ticks each; which goes first alternates from round to round. The medians over N
+// rounds (200 unless given) of the time per tick are reported. Only the dispatch is timed: the world itself does
+// not move, so its bacteria and pits, which neither way runs, stay as they are.
+
+#include "StudentWorld.h"
+#include "UpdateScheduler.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+using namespace std;
+
+namespace {
+    enum Kind {
+        KIND_SPRAY, KIND_FLAME_BURST, KIND_DIRT, KIND_FOOD, KIND_RESTORE_HEALTH, KIND_FLAMETHROWER, KIND_EXTRA_LIFE,
+        KIND_FUNGUS
+    };
+    const Kind MIX[] = { // each actor's kind is drawn from these
+        KIND_SPRAY, KIND_SPRAY, KIND_SPRAY, KIND_SPRAY, KIND_SPRAY, KIND_SPRAY, KIND_FLAME_BURST, KIND_DIRT, KIND_DIRT,
+        KIND_DIRT, KIND_FOOD, KIND_FOOD, KIND_FOOD, KIND_RESTORE_HEALTH, KIND_FLAMETHROWER, KIND_EXTRA_LIFE, KIND_FUNGUS
+    };
+    const int TICKS_PER_ROUND = 8; // a spray lives 14 ticks, so most of them are still flying at the end
+    const double SPREAD = VIEW_RADIUS - SPRITE_WIDTH; // actors are placed within this distance of the middle
+
+    enum Dispatch { BUCKETED, INTERLEAVED };
+
+    struct Result {
+        double bucketed; // median tick time in microseconds
+        double interleaved;
+    };
+
+    double median(vector<double> &times) {
+        sort(times.begin(), times.end());
+        return (times.empty() ? 0.0 : times[times.size() / 2]);
+    }
+
+    template <typename T>
+    void add(StudentWorld &world, ActorPools &pools, UpdateScheduler &scheduler, vector<Actor*> &actors, double x, double y, int dir) {
+        T* a = pools.create<T>(&world, x, y, dir);
+        scheduler.add(a); // the static type picks the bucket, as in StudentWorld::spawn
+        actors.push_back(a);
+    }
+
+    template <typename T>
+    void add(StudentWorld &world, ActorPools &pools, UpdateScheduler &scheduler, vector<Actor*> &actors, double x, double y) {
+        T* a = pools.create<T>(&world, x, y);
+        scheduler.add(a);
+        actors.push_back(a);
+    }
+
+    // the same actors, in the same order, for the same seed; the goodies draw their lifetimes from the world, which
+    // is in the same state in both copies
+    void populate(StudentWorld &world, ActorPools &pools, UpdateScheduler &scheduler, vector<Actor*> &actors, int n, uint64_t seed) {
+        RandomEngine random(seed);
+        for (int i = 0; i < n; i++) {
+            double x, y;
+            do {
+                x = random.randInt(0, VIEW_WIDTH - 1);
+                y = random.randInt(0, VIEW_HEIGHT - 1);
+            } while (distanceSquared(x, y, VIEW_WIDTH / 2, VIEW_HEIGHT / 2) > SPREAD * SPREAD);
+            int dir = random.randInt(0, 359);
+            switch (MIX[random.randInt(0, sizeof(MIX) / sizeof(MIX[0]) - 1)]) {
+                case KIND_SPRAY: add<Spray>(world, pools, scheduler, actors, x, y, dir); break;
+                case KIND_FLAME_BURST: add<FlameBurst>(world, pools, scheduler, actors, x, y, dir); break;
+                case KIND_DIRT: add<DirtPile>(world, pools, scheduler, actors, x, y); break;
+                case KIND_FOOD: add<Food>(world, pools, scheduler, actors, x, y); break;
+                case KIND_RESTORE_HEALTH: add<RestoreHealthGoodie>(world, pools, scheduler, actors, x, y); break;
+                case KIND_FLAMETHROWER: add<FlameThrowerGoodie>(world, pools, scheduler, actors, x, y); break;
+                case KIND_EXTRA_LIFE: add<ExtraLifeGoodie>(world, pools, scheduler, actors, x, y); break;
+                case KIND_FUNGUS: add<Fungus>(world, pools, scheduler, actors, x, y); break;
+            }
+        }
+    }
+
+    // microseconds per tick, or a negative number if the world could not be set up
+    double timeRound(Dispatch dispatch, int n, uint64_t seed) {
+        StudentWorld world("", seed);
+        if (world.init() != GWSTATUS_CONTINUE_GAME)
+            return -1;
+
+        // the actors come from pools of their own, and are dropped with them without being destroyed, the way the
+        // world drops a level; the world is cleaned up first, so that it forgets them before the arena goes
+        LevelArena arena;
+        ActorPools pools(arena);
+        UpdateScheduler scheduler;
+        vector<Actor*> actors;
+        populate(world, pools, scheduler, actors, n, seed);
+
+        auto start = chrono::steady_clock::now();
+        for (int tick = 0; tick < TICKS_PER_ROUND; tick++) {
+            if (dispatch == BUCKETED)
+                scheduler.run();
+            else {
+                for (auto &a : actors)
+                    if (a->isAlive())
+                        a->doSomething();
+            }
+        }
+        double micros = chrono::duration<double, micro>(chrono::steady_clock::now() - start).count();
+        world.cleanUp();
+        return micros / TICKS_PER_ROUND;
+    }
+
+    Result measure(int rounds, int n, uint64_t seed) {
+        vector<double> bucketed, interleaved;
+        for (int round = 0; round < rounds; round++) {
+            Dispatch first = (round % 2 == 0 ? BUCKETED : INTERLEAVED);
+            Dispatch second = (first == BUCKETED ? INTERLEAVED : BUCKETED);
+            double a = timeRound(first, n, seed + round), b = timeRound(second, n, seed + round);
+            if (a < 0 || b < 0)
+                continue;
+            (first == BUCKETED ? bucketed : interleaved).push_back(a);
+            (second == BUCKETED ? bucketed : interleaved).push_back(b);
+        }
+        return Result{median(bucketed), median(interleaved)};
+    }
+
+    void usage() {
+        fprintf(stderr, "usage: kontagion-bench-dispatch [--rounds N] [--actors N] [--seed S]\n");
+        exit(2);
+    }
+
+    long long numberArgument(int argc, char* argv[], int &i) {
+        if (i + 1 >= argc)
+            usage();
+        char* end;
+        long long value = strtoll(argv[++i], &end, 10);
+        if (*end != '\0' || value < 0)
+            usage();
+        return value;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    long long rounds = 200, actors = 400;
+    uint64_t seed = 1;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--rounds") == 0)
+            rounds = numberArgument(argc, argv, i);
+        else if (strcmp(argv[i], "--actors") == 0)
+            actors = numberArgument(argc, argv, i);
+        else if (strcmp(argv[i], "--seed") == 0)
+            seed = (uint64_t) numberArgument(argc, argv, i);
+        else
+            usage();
+    }
+    if (rounds < 1 || actors > 100000)
+        usage();
+
+    Result r = measure((int) rounds, (int) actors, seed);
+    printf("actors %lld  rounds %lld\n", actors, rounds);
+    printf("bucketed     %8.2f us/tick\n", r.bucketed);
+    printf("interleaved  %8.2f us/tick\n", r.interleaved);
+    if (r.bucketed > 0)
+        printf("interleaved / bucketed  %.3f\n", r.interleaved / r.bucketed);
+    return 0;
+}
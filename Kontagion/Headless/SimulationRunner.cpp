@@ -0,0 +1,142 @@
+// Command-line runner for the simulation: plays the game without a window, from a seed and a script of key
+// presses, and reports how fast the world ticks.
+//
+//   kontagion-sim [--ticks N] [--levels N] [--seed S] [--input FILE] [--threads N] [--check-allocations N]
+//
+// Stops after N ticks (100000 unless given) or once N levels have been finished, whichever comes first. When a
+// game is over the next one starts from the next seed, so any number of ticks can be run. With --threads the
+// world ticks in two phases on that many threads, which gives the same game for any N. With --check-allocations
+// the runner counts the memory allocations made during the ticks of a world that has already run N ticks, by which
+// time its containers have grown to fit what it holds, and fails if there are any. The occupancy of the actor pools
+// of the last world is reported at the end.
+
+#include "StudentWorld.h"
+#include "ScriptedFrontend.h"
+#include "WorkerPool.h"
+#include "AllocationCounter.h"
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+using namespace std;
+
+namespace {
+    const int RANDOM_SCRIPT_TICKS = 4096; // length of the generated script when none is given
+
+    void usage() {
+        fprintf(stderr, "usage: kontagion-sim [--ticks N] [--levels N] [--seed S] [--input FILE] [--threads N] [--check-allocations N]\n");
+        exit(2);
+    }
+
+    long long numberArgument(int argc, char* argv[], int &i) {
+        if (i + 1 >= argc)
+            usage();
+        char* end;
+        long long value = strtoll(argv[++i], &end, 10);
+        if (*end != '\0' || value < 0)
+            usage();
+        return value;
+    }
+
+    StudentWorld* startGame(uint64_t seed, GameFrontend &frontend, WorkerPool* workers) {
+        StudentWorld* gw = new StudentWorld("", seed);
+        gw->setFrontend(&frontend);
+        gw->setWorkers(workers);
+        return gw;
+    }
+
+    void printPoolStats(const StudentWorld &world) {
+        printf("pool  object size  slabs  capacity  in use  peak\n");
+        int n = 0;
+        for (auto &s : world.poolStats())
+            printf("%4d  %11zu  %5zu  %8zu  %6zu  %4zu\n", n++, s.objectSize, s.slabs, s.capacity, s.inUse, s.peakInUse);
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    long long maxTicks = 100000, maxLevels = -1, warmUp = -1;
+    uint64_t seed = 1;
+    string inputFile;
+    unique_ptr<WorkerPool> workers;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--ticks") == 0)
+            maxTicks = numberArgument(argc, argv, i);
+        else if (strcmp(argv[i], "--levels") == 0)
+            maxLevels = numberArgument(argc, argv, i);
+        else if (strcmp(argv[i], "--seed") == 0)
+            seed = (uint64_t) numberArgument(argc, argv, i);
+        else if (strcmp(argv[i], "--input") == 0 && i + 1 < argc)
+            inputFile = argv[++i];
+        else if (strcmp(argv[i], "--threads") == 0) {
+            long long threads = numberArgument(argc, argv, i);
+            if (threads < 1 || threads > 1024)
+                usage();
+            workers.reset(new WorkerPool((int) threads));
+        }
+        else if (strcmp(argv[i], "--check-allocations") == 0)
+            warmUp = numberArgument(argc, argv, i);
+        else
+            usage();
+    }
+
+    vector<int> keys;
+    if (inputFile.empty())
+        keys = ScriptedFrontend::randomScript(seed, RANDOM_SCRIPT_TICKS);
+    else if (!ScriptedFrontend::readScript(inputFile, keys)) {
+        fprintf(stderr, "kontagion-sim: cannot read a key script from %s\n", inputFile.c_str());
+        return 1;
+    }
+    ScriptedFrontend frontend(keys);
+
+    long long ticks = 0, levels = 0, deaths = 0, games = 1, age = 0, checkedTicks = 0;
+    StudentWorld* gw = startGame(seed, frontend, workers.get());
+    auto start = chrono::steady_clock::now();
+    int status = gw->init();
+    while (status != GWSTATUS_LEVEL_ERROR && ticks < maxTicks && levels != maxLevels && !frontend.quitRequested()) {
+        bool checked = (warmUp >= 0 && age >= warmUp);
+        AllocationCounter::setCounting(checked);
+        status = gw->move();
+        AllocationCounter::setCounting(false);
+        ticks++;
+        age++;
+        checkedTicks += checked;
+        if (status == GWSTATUS_FINISHED_LEVEL) {
+            levels++;
+            gw->advanceToNextLevel();
+            gw->cleanUp();
+            status = gw->init();
+        }
+        else if (status == GWSTATUS_PLAYER_DIED) {
+            deaths++;
+            gw->cleanUp();
+            if (gw->isGameOver()) {
+                delete gw;
+                gw = startGame(seed + games++, frontend, workers.get());
+                age = 0;
+            }
+            status = gw->init();
+        }
+    }
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    if (status == GWSTATUS_LEVEL_ERROR)
+        fprintf(stderr, "kontagion-sim: level %d could not be laid out\n", gw->getLevel());
+    printf("ticks %lld  levels %lld  deaths %lld  games %lld  level %d  score %d\n", ticks, levels, deaths, games, gw->getLevel(), gw->getScore());
+    printf("%.3f s  %.0f ticks/s\n", seconds, ticks / seconds);
+    printPoolStats(*gw);
+    gw->cleanUp();
+    delete gw;
+    if (warmUp >= 0) {
+        printf("allocations %lld in %lld ticks of worlds older than %lld ticks\n", AllocationCounter::count(), checkedTicks, warmUp);
+        if (AllocationCounter::count() > 0) {
+            fprintf(stderr, "kontagion-sim: the world allocated memory after warming up\n");
+            return 1;
+        }
+    }
+    return (status == GWSTATUS_LEVEL_ERROR ? 1 : 0);
+}
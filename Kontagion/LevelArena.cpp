@@ -0,0 +1,81 @@
+#include "LevelArena.h"
+#include <algorithm>
+#include <new>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+using namespace std;
+
+const size_t LevelArena::CHUNK_SIZE; // passed by reference to max, so it needs a definition
+
+LevelArena::LevelArena(bool hugePages) {
+    m_hugePages = hugePages;
+    m_current = 0;
+    m_offset = 0;
+    m_usedBefore = 0;
+}
+
+LevelArena::~LevelArena() {
+    for (auto &chunk : m_chunks) {
+#if defined(__linux__) && defined(MAP_HUGETLB)
+        if (chunk.huge) {
+            munmap(chunk.memory, chunk.bytes);
+            continue;
+        }
+#endif
+        ::operator delete(chunk.memory);
+    }
+}
+
+void* LevelArena::allocate(size_t bytes, size_t alignment) {
+    // move on through the chunks until one has room, adding a new one at the end if none does
+    while (true) {
+        if (m_current < m_chunks.size()) {
+            size_t start = (m_offset + alignment - 1) / alignment * alignment;
+            if (start + bytes <= m_chunks[m_current].bytes) {
+                m_offset = start + bytes;
+                return m_chunks[m_current].memory + start;
+            }
+            if (m_current + 1 == m_chunks.size())
+                addChunk(max(CHUNK_SIZE, bytes + alignment));
+            m_usedBefore += m_chunks[m_current].bytes;
+            m_current++;
+            m_offset = 0;
+        }
+        else
+            addChunk(max(CHUNK_SIZE, bytes + alignment));
+    }
+}
+
+void LevelArena::reset() {
+    m_current = 0;
+    m_offset = 0;
+    m_usedBefore = 0;
+}
+
+size_t LevelArena::bytesInUse() const {
+    return m_usedBefore + m_offset;
+}
+
+size_t LevelArena::bytesReserved() const {
+    size_t total = 0;
+    for (auto &chunk : m_chunks)
+        total += chunk.bytes;
+    return total;
+}
+
+void LevelArena::addChunk(size_t bytes) {
+#if defined(__linux__) && defined(MAP_HUGETLB)
+    if (m_hugePages) {
+        size_t rounded = (bytes + CHUNK_SIZE - 1) / CHUNK_SIZE * CHUNK_SIZE;
+        void* memory = mmap(nullptr, rounded, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (memory != MAP_FAILED) {
+            m_chunks.push_back(Chunk{static_cast<char*>(memory), rounded, true});
+            return;
+        }
+    }
+#endif
+    m_chunks.push_back(Chunk{static_cast<char*>(::operator new(bytes)), bytes, false}); // aligned for max_align_t
+}
@@ -0,0 +1,50 @@
+#ifndef LEVELARENA_H_
+#define LEVELARENA_H_
+
+#include <vector>
+#include <cstddef>
+
+// Define KONTAGION_HUGE_PAGES to back the arena with 2 MB huge pages on Linux systems that have some reserved;
+// chunks quietly fall back to ordinary memory when none are available.
+#ifdef KONTAGION_HUGE_PAGES
+#define LEVEL_ARENA_HUGE_PAGES true
+#else
+#define LEVEL_ARENA_HUGE_PAGES false
+#endif
+
+// Bump allocator for everything that lives exactly as long as a level. Memory is handed out from large chunks by
+// advancing an offset, and reset() makes all of it available again by rewinding to the first chunk without looking
+// at what was allocated, so dropping a level costs the same however many objects it had. Nothing allocated here is
+// ever destroyed. Chunks are kept across resets, so once the arena has grown to what the biggest level needs it no
+// longer asks the system for memory.
+class LevelArena {
+public:
+    static const size_t CHUNK_SIZE = 2 * 1024 * 1024; // one huge page
+
+    explicit LevelArena(bool hugePages = LEVEL_ARENA_HUGE_PAGES);
+    ~LevelArena();
+    void* allocate(size_t bytes, size_t alignment = alignof(std::max_align_t));
+    void reset();
+    size_t bytesInUse() const;
+    size_t bytesReserved() const;
+
+    LevelArena(const LevelArena&) = delete;
+    LevelArena& operator=(const LevelArena&) = delete;
+
+private:
+    struct Chunk {
+        char* memory;
+        size_t bytes;
+        bool huge;
+    };
+
+    bool m_hugePages;
+    std::vector<Chunk> m_chunks;
+    size_t m_current; // chunk that allocations are currently served from
+    size_t m_offset; // first free byte in the current chunk
+    size_t m_usedBefore; // bytes handed out from the chunks before the current one, including what was skipped
+
+    void addChunk(size_t bytes);
+};
+
+#endif // LEVELARENA_H_
@@ -0,0 +1,52 @@
+#include "LevelLayout.h"
+#include "Actor.h"
+#include <algorithm>
+#include <new>
+
+using namespace std;
+
+LevelLayout::LevelLayout(LevelArena &arena, RandomEngine &random) : m_arena(&arena), m_random(&random), m_cells(CELLS_PER_SIDE * CELLS_PER_SIDE, nullptr) {}
+
+// the spots of the previous level went with its arena, only the cells have to be emptied
+void LevelLayout::clear() {
+    fill(m_cells.begin(), m_cells.end(), nullptr);
+}
+
+void LevelLayout::placeAnywhere(double &x, double &y) {
+    randomSpot(x, y);
+    record(x, y);
+}
+
+bool LevelLayout::placeSpaced(double &x, double &y) {
+    for (int attempt = 0; attempt < MAX_ATTEMPTS; attempt++) {
+        randomSpot(x, y);
+        if (isSpaced(x, y)) {
+            record(x, y);
+            return true;
+        }
+    }
+    return false;
+}
+
+// objects are spread over the inner part of the dish by picking a random angle and distance from the center
+void LevelLayout::randomSpot(double &x, double &y) {
+    int angle = m_random->randInt(0, 359);
+    int dist = m_random->randInt(0, 120);
+    x = xCoordinateFromCenter(dist, angle);
+    y = yCoordinateFromCenter(dist, angle);
+}
+
+bool LevelLayout::isSpaced(double x, double y) const {
+    int cx = cellCoordinate(x), cy = cellCoordinate(y);
+    for (int ny = max(cy - 1, 0); ny <= min(cy + 1, CELLS_PER_SIDE - 1); ny++)
+        for (int nx = max(cx - 1, 0); nx <= min(cx + 1, CELLS_PER_SIDE - 1); nx++)
+            for (Spot* p = m_cells[ny * CELLS_PER_SIDE + nx]; p != nullptr; p = p->next)
+                if (distanceSquared(p->x, p->y, x, y) <= SPRITE_WIDTH * SPRITE_WIDTH)
+                    return false;
+    return true;
+}
+
+void LevelLayout::record(double x, double y) {
+    Spot* &first = m_cells[cellCoordinate(y) * CELLS_PER_SIDE + cellCoordinate(x)];
+    first = new (m_arena->allocate(sizeof(Spot), alignof(Spot))) Spot{x, y, first};
+}
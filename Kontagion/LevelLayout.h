@@ -0,0 +1,43 @@
+#ifndef LEVELLAYOUT_H_
+#define LEVELLAYOUT_H_
+
+#include "GameConstants.h"
+#include "LevelArena.h"
+#include "RandomEngine.h"
+#include <vector>
+#include <algorithm>
+
+// Picks random spots inside the dish for the objects of a new level. Pits and food must not lie within SPRITE_WIDTH
+// of anything placed before them, so every spot handed out is filed in a grid of SPRITE_WIDTH cells and a candidate
+// only has to be compared with what is in the 3x3 cells around it. Each object gets a bounded number of candidates,
+// so laying out a level takes the same time no matter how crowded the dish is or how long the session has run.
+// The spots themselves are allocated from the level's arena and vanish with it.
+class LevelLayout {
+public:
+    static const int MAX_ATTEMPTS = 500; // candidates tried for one spaced object before giving up on it
+
+    LevelLayout(LevelArena &arena, RandomEngine &random);
+    void clear(); // forgets everything placed, to be called before laying out every level
+    void placeAnywhere(double &x, double &y); // for dirt piles, which may overlap each other
+    bool placeSpaced(double &x, double &y); // false if no free spot turned up within MAX_ATTEMPTS candidates
+
+private:
+    static const int CELL_SIZE = SPRITE_WIDTH; // equal to the spacing, so conflicts are always in neighbouring cells
+    static const int CELLS_PER_SIDE = VIEW_WIDTH / CELL_SIZE;
+
+    struct Spot {
+        double x, y;
+        Spot* next; // next spot in the same cell
+    };
+
+    LevelArena* m_arena;
+    RandomEngine* m_random; // the world's generator, so that a level is laid out the same way from the same seed
+    std::vector<Spot*> m_cells; // first of the spots placed so far in each cell
+
+    void randomSpot(double &x, double &y);
+    static int cellCoordinate(double c) { return std::min(std::max((int) c / CELL_SIZE, 0), CELLS_PER_SIDE - 1); }
+    bool isSpaced(double x, double y) const;
+    void record(double x, double y);
+};
+
+#endif // LEVELLAYOUT_H_
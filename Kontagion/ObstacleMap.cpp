@@ -0,0 +1,64 @@
+#include "ObstacleMap.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace std;
+
+// squared distance from (px, py) to the nearest and to the farthest point of the one pixel cell at (cx, cy)
+static void cellDistances(int cx, int cy, double px, double py, double &nearSquared, double &farSquared) {
+    double nx = min(max(px, (double) cx), (double) cx + 1) - px;
+    double ny = min(max(py, (double) cy), (double) cy + 1) - py;
+    double fx = max(fabs(cx - px), fabs(cx + 1 - px));
+    double fy = max(fabs(cy - py), fabs(cy + 1 - py));
+    nearSquared = nx * nx + ny * ny;
+    farSquared = fx * fx + fy * fy;
+}
+
+ObstacleMap::ObstacleMap()
+    : m_rim(VIEW_WIDTH * VIEW_HEIGHT), m_covered(VIEW_WIDTH * VIEW_HEIGHT), m_touched(VIEW_WIDTH * VIEW_HEIGHT)
+{
+    // the rim never changes, so it is classified once for the lifetime of the map
+    const double radiusSquared = VIEW_RADIUS * VIEW_RADIUS;
+    for (int cy = 0; cy < VIEW_HEIGHT; cy++) {
+        for (int cx = 0; cx < VIEW_WIDTH; cx++) {
+            double nearSquared, farSquared;
+            cellDistances(cx, cy, VIEW_WIDTH / 2, VIEW_HEIGHT / 2, nearSquared, farSquared);
+            if (nearSquared >= radiusSquared)
+                m_rim[cy * VIEW_WIDTH + cx] = BLOCKED;
+            else if (farSquared < radiusSquared)
+                m_rim[cy * VIEW_WIDTH + cx] = FREE;
+            else
+                m_rim[cy * VIEW_WIDTH + cx] = UNKNOWN;
+        }
+    }
+}
+
+void ObstacleMap::addPile(double x, double y) {
+    rasterizePile(x, y, 1);
+}
+
+void ObstacleMap::removePile(double x, double y) {
+    rasterizePile(x, y, -1);
+}
+
+void ObstacleMap::clear() {
+    fill(m_covered.begin(), m_covered.end(), 0);
+    fill(m_touched.begin(), m_touched.end(), 0);
+}
+
+void ObstacleMap::rasterizePile(double x, double y, int change) {
+    const double r = SPRITE_WIDTH / 2;
+    int minX = max((int) floor(x - r), 0), maxX = min((int) floor(x + r), VIEW_WIDTH - 1);
+    int minY = max((int) floor(y - r), 0), maxY = min((int) floor(y + r), VIEW_HEIGHT - 1);
+    for (int cy = minY; cy <= maxY; cy++) {
+        for (int cx = minX; cx <= maxX; cx++) {
+            double nearSquared, farSquared;
+            cellDistances(cx, cy, x, y, nearSquared, farSquared);
+            if (nearSquared > r * r)
+                continue;
+            m_touched[cy * VIEW_WIDTH + cx] += change;
+            if (farSquared <= r * r)
+                m_covered[cy * VIEW_WIDTH + cx] += change;
+        }
+    }
+}
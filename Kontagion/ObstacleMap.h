@@ -0,0 +1,43 @@
+#ifndef OBSTACLEMAP_H_
+#define OBSTACLEMAP_H_
+
+#include "GameConstants.h"
+#include <vector>
+#include <cstdint>
+
+// Rasterized picture of everything that blocks bacteria movement: the rim of the dish and every dirt pile.
+// Each one pixel cell of the dish remembers how many blocking discs cover it completely and how many merely
+// touch it, so almost every movement test is answered by a single table lookup.
+class ObstacleMap {
+public:
+    enum Result { FREE, BLOCKED, UNKNOWN }; // UNKNOWN: a dirt pile only partly covers the cell, test exactly
+
+    ObstacleMap();
+    void addPile(double x, double y); // a dirt pile blocks everything within SPRITE_WIDTH / 2 of its center
+    void removePile(double x, double y);
+    void clear(); // forgets all dirt piles, the rim of the dish stays
+
+    Result classify(double x, double y) const {
+        if (x < 0 || y < 0 || x >= VIEW_WIDTH || y >= VIEW_HEIGHT)
+            return BLOCKED; // everything outside the bounding square is also outside the dish
+        int cell = (int) y * VIEW_WIDTH + (int) x;
+        if (m_rim[cell] == BLOCKED || (m_rim[cell] == UNKNOWN && outsideDish(x, y)))
+            return BLOCKED;
+        if (m_covered[cell] > 0)
+            return BLOCKED;
+        return (m_touched[cell] > 0 ? UNKNOWN : FREE);
+    }
+
+private:
+    std::vector<uint8_t> m_rim; // FREE, BLOCKED or UNKNOWN depending on where the cell lies relative to the rim
+    std::vector<uint16_t> m_covered; // number of dirt piles covering the whole cell
+    std::vector<uint16_t> m_touched; // number of dirt piles covering at least part of the cell
+
+    void rasterizePile(double x, double y, int change);
+    static bool outsideDish(double x, double y) {
+        double dx = x - VIEW_WIDTH / 2, dy = y - VIEW_HEIGHT / 2;
+        return (dx * dx + dy * dy >= VIEW_RADIUS * VIEW_RADIUS);
+    }
+};
+
+#endif // OBSTACLEMAP_H_
@@ -0,0 +1,45 @@
+#include "ProximityKernel.h"
+
+#if defined(__AVX__) || defined(__SSE2__) || defined(_M_X64)
+#include <immintrin.h>
+#endif
+
+int pointsWithinRadius(double qx, double qy, double radiusSquared, const double* xs, const double* ys, int n, int* out) {
+    int found = 0;
+    int i = 0;
+
+#if defined(__AVX__)
+    // four points per step
+    const __m256d px = _mm256_set1_pd(qx), py = _mm256_set1_pd(qy), limit = _mm256_set1_pd(radiusSquared);
+    for ( ; i + 4 <= n; i += 4) {
+        __m256d dx = _mm256_sub_pd(_mm256_loadu_pd(xs + i), px);
+        __m256d dy = _mm256_sub_pd(_mm256_loadu_pd(ys + i), py);
+        __m256d squared = _mm256_add_pd(_mm256_mul_pd(dx, dx), _mm256_mul_pd(dy, dy));
+        int hits = _mm256_movemask_pd(_mm256_cmp_pd(squared, limit, _CMP_LE_OQ));
+        for (int lane = 0; hits != 0; lane++, hits >>= 1)
+            if (hits & 1)
+                out[found++] = i + lane;
+    }
+#elif defined(__SSE2__) || defined(_M_X64)
+    // two points per step
+    const __m128d px = _mm_set1_pd(qx), py = _mm_set1_pd(qy), limit = _mm_set1_pd(radiusSquared);
+    for ( ; i + 2 <= n; i += 2) {
+        __m128d dx = _mm_sub_pd(_mm_loadu_pd(xs + i), px);
+        __m128d dy = _mm_sub_pd(_mm_loadu_pd(ys + i), py);
+        __m128d squared = _mm_add_pd(_mm_mul_pd(dx, dx), _mm_mul_pd(dy, dy));
+        int hits = _mm_movemask_pd(_mm_cmple_pd(squared, limit));
+        if (hits & 1)
+            out[found++] = i;
+        if (hits & 2)
+            out[found++] = i + 1;
+    }
+#endif
+
+    // whatever is left over, or everything on targets without vector support
+    for ( ; i < n; i++) {
+        double dx = xs[i] - qx, dy = ys[i] - qy;
+        if (dx * dx + dy * dy <= radiusSquared)
+            out[found++] = i;
+    }
+    return found;
+}
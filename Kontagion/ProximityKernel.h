@@ -0,0 +1,9 @@
+#ifndef PROXIMITYKERNEL_H_
+#define PROXIMITYKERNEL_H_
+
+// Batch proximity test over packed coordinate arrays. Writes to out the indices i < n for which
+// (xs[i] - qx)^2 + (ys[i] - qy)^2 <= radiusSquared, in increasing order, and returns how many there are.
+// out must have room for n indices. Uses AVX or SSE2 when the compiler targets them and plain C++ otherwise.
+int pointsWithinRadius(double qx, double qy, double radiusSquared, const double* xs, const double* ys, int n, int* out);
+
+#endif // PROXIMITYKERNEL_H_
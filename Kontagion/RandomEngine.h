@@ -0,0 +1,81 @@
+#ifndef RANDOMENGINE_H_
+#define RANDOMENGINE_H_
+
+#include <cstdint>
+#include <cmath>
+#include <climits>
+
+// xoshiro256** generator. Every GameWorld owns one, seeded when the world is created, so that a game can be replayed
+// from its seed and worlds running side by side do not share any state. Numbers in a range are taken from the high
+// bits of one 64-bit draw by multiplying instead of dividing (Lemire's method), with a rejection step that keeps
+// every value exactly equally likely and is almost never taken.
+class RandomEngine {
+public:
+    explicit RandomEngine(uint64_t seed) { reseed(seed); }
+
+    // the four words of state are spread out from the seed with splitmix64, so that similar seeds give unrelated games
+    void reseed(uint64_t seed) {
+        for (auto &word : m_state) {
+            seed += 0x9e3779b97f4a7c15ull;
+            uint64_t z = seed;
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+            word = z ^ (z >> 31);
+        }
+    }
+
+    uint64_t next() {
+        uint64_t result = rotateLeft(m_state[1] * 5, 7) * 9;
+        uint64_t t = m_state[1] << 17;
+        m_state[2] ^= m_state[0];
+        m_state[3] ^= m_state[1];
+        m_state[1] ^= m_state[2];
+        m_state[0] ^= m_state[3];
+        m_state[2] ^= t;
+        m_state[3] = rotateLeft(m_state[3], 45);
+        return result;
+    }
+
+    // a uniformly distributed int from min to max, inclusive
+    int randInt(int min, int max) {
+        if (max < min) {
+            int swap = min;
+            min = max;
+            max = swap;
+        }
+        uint32_t range = (uint32_t) ((int64_t) max - min + 1); // 0 when the range is all 2^32 ints
+        uint32_t x = (uint32_t) (next() >> 32);
+        if (range == 0)
+            return (int) ((int64_t) min + x);
+        uint64_t m = (uint64_t) x * range;
+        if ((uint32_t) m < range) {
+            uint32_t threshold = (0u - range) % range; // how many low products would make some values more likely
+            while ((uint32_t) m < threshold) {
+                x = (uint32_t) (next() >> 32);
+                m = (uint64_t) x * range;
+            }
+        }
+        return (int) ((int64_t) min + (int64_t) (m >> 32));
+    }
+
+    // uniformly distributed on [0, 1), with all 53 bits of a double's fraction random
+    double uniform() {
+        return (next() >> 11) * (1.0 / 9007199254740992.0);
+    }
+
+    // how many tries it takes until something with a 1 in n chance per try first happens, counting that try; one
+    // draw from the geometric distribution instead of one roll per try
+    int trialsUntilOneIn(int n) {
+        if (n <= 1)
+            return 1;
+        double trials = 1 + std::floor(std::log(1 - uniform()) / std::log1p(-1.0 / n));
+        return (trials < INT_MAX ? (int) trials : INT_MAX);
+    }
+
+private:
+    uint64_t m_state[4];
+
+    static uint64_t rotateLeft(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+};
+
+#endif // RANDOMENGINE_H_
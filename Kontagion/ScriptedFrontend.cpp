@@ -0,0 +1,65 @@
+#include "ScriptedFrontend.h"
+#include "GameConstants.h"
+#include "RandomEngine.h"
+#include <fstream>
+#include <map>
+#include <utility>
+
+using namespace std;
+
+const int ScriptedFrontend::NO_KEY; // bound to references when filling scripts, so it needs a definition
+
+namespace {
+    const int STAT_TEXT_SIZE = 128; // longer than the status line can get, so that copying it in never allocates
+}
+
+ScriptedFrontend::ScriptedFrontend(vector<int> keys) : m_keys(std::move(keys)) {
+    m_next = 0;
+    m_quitRequested = false;
+    m_statText.reserve(STAT_TEXT_SIZE);
+}
+
+// StudentWorld asks for at most one key per tick, so each call moves the script on by one tick
+bool ScriptedFrontend::getLastKey(int &value) {
+    if (m_keys.empty())
+        return false;
+    int key = m_keys[m_next];
+    m_next = (m_next + 1) % m_keys.size();
+    if (key == NO_KEY)
+        return false;
+    value = key;
+    return true;
+}
+
+void ScriptedFrontend::setGameStatText(const string &text) {
+    m_statText = text;
+}
+
+vector<int> ScriptedFrontend::randomScript(unsigned long long seed, int ticks) {
+    const int keys[] = {KEY_PRESS_LEFT, KEY_PRESS_RIGHT, KEY_PRESS_SPACE, KEY_PRESS_ENTER};
+    RandomEngine random(seed);
+    vector<int> script(ticks, NO_KEY);
+    for (auto &key : script)
+        if (random.randInt(0, 2) == 0)
+            key = keys[random.randInt(0, 3)];
+    return script;
+}
+
+bool ScriptedFrontend::readScript(const string &fileName, vector<int> &keys) {
+    static const map<string, int> names = {
+        {"left", KEY_PRESS_LEFT}, {"right", KEY_PRESS_RIGHT}, {"up", KEY_PRESS_UP}, {"down", KEY_PRESS_DOWN},
+        {"space", KEY_PRESS_SPACE}, {"tab", KEY_PRESS_TAB}, {"enter", KEY_PRESS_ENTER}, {".", NO_KEY},
+    };
+    ifstream in(fileName);
+    if (!in)
+        return false;
+    keys.clear();
+    string word;
+    while (in >> word) {
+        auto p = names.find(word);
+        if (p == names.end())
+            return false;
+        keys.push_back(p->second);
+    }
+    return true;
+}
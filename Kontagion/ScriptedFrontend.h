@@ -0,0 +1,40 @@
+#ifndef SCRIPTEDFRONTEND_H_
+#define SCRIPTEDFRONTEND_H_
+
+#include "GameFrontend.h"
+#include <string>
+#include <vector>
+
+// Frontend for running the game without a window. The player's keys come from a script with one entry per tick,
+// replayed from the start once it runs out; sounds are dropped and the status line is only remembered.
+class ScriptedFrontend : public GameFrontend
+{
+public:
+    static const int NO_KEY = 0; // script entry for a tick on which no key is pressed
+
+    explicit ScriptedFrontend(std::vector<int> keys);
+
+    virtual bool getLastKey(int& value);
+    virtual void playSound(int soundID) {}
+    virtual void setGameStatText(const std::string& text);
+    virtual void quitGame() { m_quitRequested = true; }
+
+    bool quitRequested() const { return m_quitRequested; }
+    const std::string& statText() const { return m_statText; }
+
+    // script of the given length in which a random key (left, right, spray or flames) is pressed on about one tick
+    // in three, the same for the same seed
+    static std::vector<int> randomScript(unsigned long long seed, int ticks);
+
+    // reads a script of whitespace-separated entries, one per tick: left, right, up, down, space, tab, enter or "."
+    // for no key; false if the file cannot be read or contains anything else
+    static bool readScript(const std::string& fileName, std::vector<int>& keys);
+
+private:
+    std::vector<int> m_keys;
+    size_t m_next; // entry for the next tick
+    bool m_quitRequested;
+    std::string m_statText;
+};
+
+#endif // SCRIPTEDFRONTEND_H_
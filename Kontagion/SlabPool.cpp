@@ -0,0 +1,81 @@
+#include "SlabPool.h"
+#include <algorithm>
+
+using namespace std;
+
+SlabPool::SlabPool(size_t objectSize, LevelArena &arena, size_t objectsPerSlab) {
+    const size_t alignment = alignof(max_align_t);
+    m_arena = &arena;
+    m_objectSize = objectSize;
+    m_slotSize = sizeof(SlotHeader) + (max(objectSize, sizeof(FreeSlot)) + alignment - 1) / alignment * alignment;
+    m_objectsPerSlab = max<size_t>(objectsPerSlab, 1);
+    m_peakInUse = 0;
+    reset();
+}
+
+void* SlabPool::allocate() {
+    void* p;
+    if (m_free != nullptr) {
+        p = m_free;
+        m_free = m_free->next;
+    }
+    else {
+        if (m_unusedSlots == 0) {
+            m_unused = static_cast<char*>(m_arena->allocate(m_slotSize * m_objectsPerSlab));
+            m_unusedSlots = m_objectsPerSlab;
+            m_slabs++;
+        }
+        reinterpret_cast<SlotHeader*>(m_unused)->pool = this;
+        p = m_unused + sizeof(SlotHeader);
+        m_unused += m_slotSize;
+        m_unusedSlots--;
+    }
+    m_inUse++;
+    m_peakInUse = max(m_peakInUse, m_inUse);
+    return p;
+}
+
+void SlabPool::release(void* p) {
+    if (p == nullptr)
+        return;
+    SlotHeader* header = reinterpret_cast<SlotHeader*>(static_cast<char*>(p) - sizeof(SlotHeader));
+    SlabPool* pool = header->pool;
+    FreeSlot* slot = static_cast<FreeSlot*>(p);
+    slot->next = pool->m_free;
+    pool->m_free = slot;
+    pool->m_inUse--;
+}
+
+void SlabPool::reset() {
+    m_free = nullptr;
+    m_unused = nullptr;
+    m_unusedSlots = 0;
+    m_slabs = 0;
+    m_inUse = 0;
+}
+
+SlabPool::Stats SlabPool::stats() const {
+    return Stats{m_objectSize, m_slabs, m_slabs * m_objectsPerSlab, m_inUse, m_peakInUse};
+}
+
+void ActorPools::reset() {
+    for (auto &pool : m_pools)
+        if (pool != nullptr)
+            pool->reset();
+}
+
+vector<SlabPool::Stats> ActorPools::stats() const {
+    vector<SlabPool::Stats> result;
+    for (auto &pool : m_pools)
+        if (pool != nullptr)
+            result.push_back(pool->stats());
+    return result;
+}
+
+SlabPool& ActorPools::poolFor(size_t index, size_t objectSize) {
+    if (index >= m_pools.size())
+        m_pools.resize(index + 1);
+    if (m_pools[index] == nullptr)
+        m_pools[index].reset(new SlabPool(objectSize, *m_arena));
+    return *m_pools[index];
+}
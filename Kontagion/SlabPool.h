@@ -0,0 +1,102 @@
+#ifndef SLABPOOL_H_
+#define SLABPOOL_H_
+
+#include "LevelArena.h"
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <utility>
+
+// Fixed-size allocator for one kind of object. Slabs of many objects at a time are taken from a LevelArena, and
+// freed objects go onto a free list from which the next allocation is served, so once a pool has grown to the most
+// objects it has to hold at once, allocating and freeing never leave the pool. Every slot starts with a pointer back
+// to its pool, so memory can be released without knowing which pool it came from. reset() forgets every object and
+// slab at once, for when the arena they live in is reset.
+class SlabPool {
+public:
+    struct Stats {
+        size_t objectSize; // bytes per object
+        size_t slabs; // slabs taken from the arena since the last reset
+        size_t capacity; // objects that fit in those slabs
+        size_t inUse; // objects currently allocated
+        size_t peakInUse; // most objects allocated at once so far
+    };
+
+    SlabPool(size_t objectSize, LevelArena &arena, size_t objectsPerSlab = 64);
+    void* allocate();
+    static void release(void* p); // p must have come from allocate() of some SlabPool
+    void reset();
+    Stats stats() const;
+
+    SlabPool(const SlabPool&) = delete;
+    SlabPool& operator=(const SlabPool&) = delete;
+
+private:
+    struct alignas(std::max_align_t) SlotHeader {
+        SlabPool* pool;
+    };
+    struct FreeSlot {
+        FreeSlot* next;
+    };
+
+    LevelArena* m_arena;
+    size_t m_objectSize;
+    size_t m_slotSize; // header plus object, rounded up so that every slot stays aligned
+    size_t m_objectsPerSlab;
+    FreeSlot* m_free; // released slots, chained through their object part
+    char* m_unused; // slots of the newest slab that were never handed out, carved off one at a time
+    size_t m_unusedSlots;
+    size_t m_slabs;
+    size_t m_inUse;
+    size_t m_peakInUse;
+};
+
+// One SlabPool per concrete type that is created through it, made the first time that type is created.
+class ActorPools {
+public:
+    explicit ActorPools(LevelArena &arena) : m_arena(&arena) {}
+
+    template <typename T, typename... Args>
+    T* create(Args&&... args) {
+        static_assert(alignof(T) <= alignof(std::max_align_t), "SlabPool slots are only aligned for ordinary types");
+        void* p = poolFor(typeIndex<T>(), sizeof(T)).allocate();
+        return new (p) T(std::forward<Args>(args)...);
+    }
+
+    // T must have a virtual destructor if object may point to a subclass
+    template <typename T>
+    static void destroy(T* object) {
+        void* p = dynamic_cast<void*>(object); // start of the complete object, which is what the pool handed out
+        object->~T();
+        SlabPool::release(p);
+    }
+
+    // sets up the pools for these types now, rather than when the first object of each is created
+    template <typename... Ts>
+    void prepare() {
+        (poolFor(typeIndex<Ts>(), sizeof(Ts)), ...);
+    }
+
+    void reset(); // forgets every object in every pool without destroying them
+    std::vector<SlabPool::Stats> stats() const;
+
+private:
+    LevelArena* m_arena;
+    std::vector<std::unique_ptr<SlabPool>> m_pools; // indexed by typeIndex, empty for types not created yet
+
+    SlabPool& poolFor(size_t index, size_t objectSize);
+
+    static size_t nextTypeIndex() {
+        static std::atomic<size_t> next{0};
+        return next++;
+    }
+    template <typename T>
+    static size_t typeIndex() {
+        static const size_t index = nextTypeIndex(); // the same for every ActorPools, so it can index all of them
+        return index;
+    }
+};
+
+#endif // SLABPOOL_H_
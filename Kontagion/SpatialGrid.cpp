@@ -0,0 +1,232 @@
+#include "SpatialGrid.h"
+#include "ProximityKernel.h"
+#include "Actor.h"
+#include <algorithm>
+
+using namespace std;
+
+namespace {
+    const int BATCH = 64; // bucket entries handed to the proximity kernel at a time
+    const int RESERVED_PER_CELL = 8;
+
+    // how far along the segment the point closest to (x, y) is, from 0 at (x0, y0) to 1 at (x1, y1)
+    double alongSegment(double x, double y, double x0, double y0, double x1, double y1) {
+        double dx = x1 - x0, dy = y1 - y0;
+        double lengthSquared = dx * dx + dy * dy;
+        if (lengthSquared == 0)
+            return 0.0;
+        return max(0.0, min(1.0, ((x - x0) * dx + (y - y0) * dy) / lengthSquared));
+    }
+}
+
+SpatialGrid::SpatialGrid(int cellSize) {
+    m_cellSize = cellSize;
+    m_cellsPerSide = (VIEW_WIDTH + cellSize - 1) / cellSize;
+    m_cells.resize(m_cellsPerSide * m_cellsPerSide);
+
+    // room for a few actors per bucket up front, so that actors moving around do not allocate every time one of
+    // them enters a bucket for the first time
+    for (auto &cell : m_cells) {
+        cell.xs.reserve(RESERVED_PER_CELL);
+        cell.ys.reserve(RESERVED_PER_CELL);
+        cell.entries.reserve(RESERVED_PER_CELL);
+    }
+}
+
+void SpatialGrid::insert(Actor *a) {
+    Cell &cell = m_cells[cellIndex(a->getX(), a->getY())];
+    cell.xs.push_back(a->getX());
+    cell.ys.push_back(a->getY());
+    cell.entries.push_back(Entry{a, a->getCategories()});
+}
+
+void SpatialGrid::remove(Actor *a) {
+    Cell &cell = m_cells[cellIndex(a->getX(), a->getY())];
+    int i = find(cell, a);
+    if (i >= 0)
+        eraseAt(cell, i);
+}
+
+void SpatialGrid::move(Actor *a, double oldX, double oldY) {
+    Cell &oldCell = m_cells[cellIndex(oldX, oldY)];
+    Cell &newCell = m_cells[cellIndex(a->getX(), a->getY())];
+
+    // actors that were never filed (e.g. Socrates) are simply not found in their old bucket and stay unfiled
+    int i = find(oldCell, a);
+    if (i < 0)
+        return;
+    if (&oldCell == &newCell) {
+        oldCell.xs[i] = a->getX();
+        oldCell.ys[i] = a->getY();
+        return;
+    }
+    Entry e = oldCell.entries[i];
+    eraseAt(oldCell, i);
+    newCell.xs.push_back(a->getX());
+    newCell.ys.push_back(a->getY());
+    newCell.entries.push_back(e);
+}
+
+void SpatialGrid::clear() {
+    for (auto &cell : m_cells) {
+        cell.xs.clear();
+        cell.ys.clear();
+        cell.entries.clear();
+    }
+}
+
+Actor* SpatialGrid::findBest(double x, double y, double r, initializer_list<int> priorities) const {
+    int any = 0;
+    for (int mask : priorities)
+        any |= mask;
+
+    Actor* best = nullptr;
+    int bestRank = 0;
+    double bestSquared = 0;
+    int hits[BATCH];
+    int minX = cellCoordinate(x - r), maxX = cellCoordinate(x + r);
+    int minY = cellCoordinate(y - r), maxY = cellCoordinate(y + r);
+    for (int cy = minY; cy <= maxY; cy++) {
+        for (int cx = minX; cx <= maxX; cx++) {
+            const Cell &cell = m_cells[cy * m_cellsPerSide + cx];
+            int size = (int) cell.entries.size();
+            for (int start = 0; start < size; start += BATCH) {
+                int found = pointsWithinRadius(x, y, r * r, cell.xs.data() + start, cell.ys.data() + start, min(BATCH, size - start), hits);
+                for (int h = 0; h < found; h++) {
+                    int i = start + hits[h];
+                    const Entry &e = cell.entries[i];
+                    if (!(e.categories & any) || !e.actor->isAlive())
+                        continue;
+                    int rank = 0;
+                    for (int mask : priorities) {
+                        if (e.categories & mask)
+                            break;
+                        rank++;
+                    }
+                    double dx = cell.xs[i] - x, dy = cell.ys[i] - y;
+                    double squared = dx * dx + dy * dy;
+                    if (best == nullptr || rank < bestRank || (rank == bestRank && squared < bestSquared)) {
+                        best = e.actor;
+                        bestRank = rank;
+                        bestSquared = squared;
+                    }
+                }
+            }
+        }
+    }
+    return best;
+}
+
+void SpatialGrid::withinRadius(double x, double y, double r, int categories, vector<Actor*> &out) const {
+    int hits[BATCH];
+    int minX = cellCoordinate(x - r), maxX = cellCoordinate(x + r);
+    int minY = cellCoordinate(y - r), maxY = cellCoordinate(y + r);
+    for (int cy = minY; cy <= maxY; cy++) {
+        for (int cx = minX; cx <= maxX; cx++) {
+            const Cell &cell = m_cells[cy * m_cellsPerSide + cx];
+            int size = (int) cell.entries.size();
+            for (int start = 0; start < size; start += BATCH) {
+                int found = pointsWithinRadius(x, y, r * r, cell.xs.data() + start, cell.ys.data() + start, min(BATCH, size - start), hits);
+                for (int h = 0; h < found; h++) {
+                    const Entry &e = cell.entries[start + hits[h]];
+                    if ((e.categories & categories) && e.actor->isAlive())
+                        out.push_back(e.actor);
+                }
+            }
+        }
+    }
+}
+
+void SpatialGrid::nearSegment(double x0, double y0, double x1, double y1, double r, int categories, vector<Actor*> &out) const {
+    // everything near the segment lies within the circle around its midpoint that reaches r past either end
+    double dx = x1 - x0, dy = y1 - y0;
+    double lengthSquared = dx * dx + dy * dy;
+    size_t first = out.size();
+    withinRadius((x0 + x1) / 2, (y0 + y1) / 2, sqrt(lengthSquared) / 2 + r, categories, out);
+
+    // keep only the actors that are really within r of the segment
+    auto last = remove_if(out.begin() + first, out.end(), [&](Actor* a) {
+        double t = alongSegment(a->getX(), a->getY(), x0, y0, x1, y1);
+        double ex = a->getX() - (x0 + t * dx), ey = a->getY() - (y0 + t * dy);
+        return (ex * ex + ey * ey > r * r);
+    });
+    out.erase(last, out.end());
+}
+
+void SpatialGrid::orderAlongSegment(double x0, double y0, double x1, double y1, vector<Actor*>::iterator first, vector<Actor*>::iterator last) {
+    double dx = x1 - x0, dy = y1 - y0;
+    auto before = [&](Actor* a, Actor* b) {
+        double ta = alongSegment(a->getX(), a->getY(), x0, y0, x1, y1), tb = alongSegment(b->getX(), b->getY(), x0, y0, x1, y1);
+        if (ta != tb)
+            return ta < tb;
+        // at the same point of the segment (e.g. when it has no length) the closer actor comes first
+        return distanceSquared(a->getX(), a->getY(), x0 + ta * dx, y0 + ta * dy) < distanceSquared(b->getX(), b->getY(), x0 + tb * dx, y0 + tb * dy);
+    };
+
+    // a path hits a handful of actors at most, so an insertion sort does; it keeps ties in the order they were
+    // found like std::stable_sort, without the buffer that allocates on every call
+    for (auto i = first; i != last; ++i) {
+        Actor* a = *i;
+        auto j = i;
+        for ( ; j != first && before(a, *(j - 1)); --j)
+            *j = *(j - 1);
+        *j = a;
+    }
+}
+
+Actor* SpatialGrid::nearest(double x, double y, double r, int categories, const Actor* skip) const {
+    int qx = cellCoordinate(x), qy = cellCoordinate(y);
+    Actor* best = nullptr;
+    double bestSquared = r * r;
+    int hits[BATCH];
+    for (int ring = 0; ring < m_cellsPerSide; ring++) {
+        double ringDistance = (ring - 1) * m_cellSize; // no point in this ring can be closer than this
+        if (ringDistance > 0 && ringDistance * ringDistance > bestSquared)
+            break;
+        for (int cy = qy - ring; cy <= qy + ring; cy++) {
+            if (cy < 0 || cy >= m_cellsPerSide)
+                continue;
+            // rows strictly inside the ring only contribute their two edge buckets
+            int step = (cy == qy - ring || cy == qy + ring) ? 1 : 2 * ring;
+            for (int cx = qx - ring; cx <= qx + ring; cx += step) {
+                if (cx < 0 || cx >= m_cellsPerSide)
+                    continue;
+                const Cell &cell = m_cells[cy * m_cellsPerSide + cx];
+                int size = (int) cell.entries.size();
+                for (int start = 0; start < size; start += BATCH) {
+                    int found = pointsWithinRadius(x, y, bestSquared, cell.xs.data() + start, cell.ys.data() + start, min(BATCH, size - start), hits);
+                    for (int h = 0; h < found; h++) {
+                        int i = start + hits[h];
+                        const Entry &e = cell.entries[i];
+                        if (!(e.categories & categories) || !e.actor->isAlive() || e.actor == skip)
+                            continue;
+                        double dx = cell.xs[i] - x, dy = cell.ys[i] - y;
+                        double squared = dx * dx + dy * dy;
+                        if (best == nullptr || squared < bestSquared) {
+                            best = e.actor;
+                            bestSquared = squared;
+                        }
+                    }
+                }
+            }
+        }
+    }
+    return best;
+}
+
+int SpatialGrid::find(const Cell &cell, const Actor *a) const {
+    for (size_t i = 0; i < cell.entries.size(); i++)
+        if (cell.entries[i].actor == a)
+            return (int) i;
+    return -1;
+}
+
+void SpatialGrid::eraseAt(Cell &cell, int i) {
+    // order inside a bucket does not matter, so swap the last entry into the hole
+    cell.xs[i] = cell.xs.back();
+    cell.ys[i] = cell.ys.back();
+    cell.entries[i] = cell.entries.back();
+    cell.xs.pop_back();
+    cell.ys.pop_back();
+    cell.entries.pop_back();
+}
@@ -0,0 +1,71 @@
+#ifndef SPATIALGRID_H_
+#define SPATIALGRID_H_
+
+#include "GameConstants.h"
+#include <vector>
+#include <cmath>
+#include <initializer_list>
+
+class Actor;
+
+// Uniform bucket grid over the dish. Every actor is filed under the cell that contains its center, so a proximity
+// query only has to look at the handful of cells that its search circle touches instead of at every actor.
+// Each bucket keeps its actors' coordinates packed in their own arrays, so that the distance tests of a query run as
+// one batch through pointsWithinRadius, and a copy of each actor's category mask, so that the wrong kinds of actors
+// are rejected without touching the actor itself.
+class SpatialGrid {
+public:
+    SpatialGrid(int cellSize = 16);
+    void insert(Actor* a);
+    void remove(Actor* a);
+    void move(Actor* a, double oldX, double oldY); // re-files an actor after it moved away from (oldX, oldY)
+    void clear();
+
+    // single pass over the live actors within distance r of (x, y): an actor matching an earlier mask in the
+    // priority list beats one matching a later mask, and among equals the closer actor wins
+    Actor* findBest(double x, double y, double r, std::initializer_list<int> priorities) const;
+
+    // appends to out every live actor in one of the given categories whose center lies within distance r of (x, y)
+    void withinRadius(double x, double y, double r, int categories, std::vector<Actor*>& out) const;
+
+    // appends to out every live actor in one of the given categories whose center lies within distance r of the
+    // segment from (x0, y0) to (x1, y1), in no particular order
+    void nearSegment(double x0, double y0, double x1, double y1, double r, int categories, std::vector<Actor*>& out) const;
+
+    // puts the actors in [first, last) in order of how far along the segment from (x0, y0) to (x1, y1) they are,
+    // so that the results of several grids can be ordered together
+    static void orderAlongSegment(double x0, double y0, double x1, double y1, std::vector<Actor*>::iterator first, std::vector<Actor*>::iterator last);
+
+    // returns the closest live actor other than skip in one of the given categories whose center lies within
+    // distance r of (x, y)
+    // buckets are visited in rings of growing size around (x, y), stopping once no closer actor can remain
+    Actor* nearest(double x, double y, double r, int categories, const Actor* skip = nullptr) const;
+
+private:
+    struct Entry {
+        Actor* actor;
+        int categories; // copy of the actor's category mask, which never changes after construction
+    };
+    struct Cell {
+        std::vector<double> xs; // packed x coordinates, parallel to entries
+        std::vector<double> ys; // packed y coordinates, parallel to entries
+        std::vector<Entry> entries;
+    };
+
+    int m_cellSize; // side length of one bucket in pixels
+    int m_cellsPerSide; // number of buckets along each axis of the dish
+    std::vector<Cell> m_cells; // actors filed by the bucket containing their center
+
+    // objects outside the dish (e.g. flames fired from the rim) are clamped into the border buckets
+    int cellCoordinate(double v) const {
+        int c = (int) std::floor(v / m_cellSize);
+        if (c < 0) return 0;
+        if (c >= m_cellsPerSide) return m_cellsPerSide - 1;
+        return c;
+    }
+    int cellIndex(double x, double y) const { return cellCoordinate(y) * m_cellsPerSide + cellCoordinate(x); }
+    int find(const Cell& cell, const Actor* a) const;
+    void eraseAt(Cell& cell, int i);
+};
+
+#endif // SPATIALGRID_H_
@@ -2,40 +2,164 @@
 #include "GameConstants.h"
 #include <string>
 #include <iterator>
+#include <iostream>
+#include <cstdio>
 using namespace std;
 
-bool safeToCreateObjectAt(double x, double y, const LocationArray& l);
+namespace {
+    const int RESERVED_ACTORS = 256; // room in the per-tick lists of actors before they first grow
+    const int STATUS_TEXT_SIZE = 128; // longer than the status line can get
+}
 
-GameWorld* createStudentWorld(string assetPath)
+GameWorld* createStudentWorld(string assetPath, uint64_t seed)
 {
-    return new StudentWorld(assetPath);
+    return new StudentWorld(assetPath, seed);
 }
 
 // Students:  Add code to this file, StudentWorld.h, Actor.h and Actor.cpp
 
-StudentWorld::StudentWorld(string assetPath)
-: GameWorld(assetPath)
+StudentWorld::StudentWorld(string assetPath, uint64_t seed)
+: GameWorld(assetPath, seed), pools(arena), bacteriaStore(this), layout(arena, rng())
 {
     socrates = nullptr;
+    workers = nullptr;
     bacteriaRemaining = 0;
     allBacteriaReleased = false;
+    pathsToSocratesStale = true;
+    obstaclesChanged = true;
+    ticksUntilGoodie = 0;
+    ticksUntilFungus = 0;
+
+    // everything a tick works with is set up here, so that ticks only allocate while the world holds more than it
+    // ever has before
+    pools.prepare<Socrates, DirtPile, Pit, Food, Spray, FlameBurst, RestoreHealthGoodie, FlameThrowerGoodie,
+                  ExtraLifeGoodie, Fungus, RegularSalmonella, AggressiveSalmonella, Ecoli>();
+    spawned.reserve(RESERVED_ACTORS);
+    despawned.reserve(RESERVED_ACTORS);
+    dueTimers.reserve(RESERVED_ACTORS);
+    pathHits.reserve(RESERVED_ACTORS);
+    ringHits.reserve(RESERVED_ACTORS);
+    statusText.reserve(STATUS_TEXT_SIZE);
 }
 
 bool StudentWorld::levelComplete() const {
     return (allBacteriaReleased && !bacteriaRemaining);
 }
 
+// every actor enters the world through here; it joins the others, and becomes visible to queries, at the next merge
+void StudentWorld::addActor(Actor *a) {
+    a->setHandle(handles.issue(a));
+    if (a->getLifetime() > 0)
+        lifetimes.schedule(a->getHandle(), a->getLifetime());
+    spawned.push_back(a);
+}
+
+// Actors whose lifetime runs out go at the start of the tick, before anything else acts. One spawned during tick
+// T with a lifetime of L acts for the last time in tick T + L - 1, just as if it had counted down L ticks itself.
+void StudentWorld::expireActors() {
+    lifetimes.advance(dueTimers);
+    for (auto &h : dueTimers) {
+        Actor* a = findActor(h);
+        if (a != nullptr && a->isAlive()) // actors that died early are not taken off the wheel, they are just skipped
+            a->expire();
+    }
+    dueTimers.clear();
+}
+
+// Pits do nothing on most ticks, so instead of each rolling the dice every tick they are woken up on the ticks
+// they release a bacterium, drawn in advance from the same distribution; this happens where the pits used to act,
+// just before the other actors
+void StudentWorld::wakePits() {
+    pitWakeups.advance(dueTimers);
+    for (auto &h : dueTimers) {
+        Pit* p = static_cast<Pit*>(findActor(h));
+        if (p == nullptr || !p->isAlive())
+            continue;
+        p->Pit::doSomething();
+        if (p->isAlive())
+            pitWakeups.schedule(h, p->ticksUntilNextAction());
+    }
+    dueTimers.clear();
+}
+
+// one search around Socrates instead of every goodie checking on its own whether it touches him
+void StudentWorld::giveGoodiesToSocrates() {
+    for (Actor* a : actorsInRing(socrates->getX(), socrates->getY(), 0, SPRITE_WIDTH, CATEGORY_GOODIE))
+        if (a->isAlive())
+            static_cast<Goodie*>(a)->takeSpecificGoodieAction();
+}
+
+// the actor a handle was issued for, or nullptr once that actor has been removed from the world; an actor that
+// died this tick is still found until the end of the tick, so check isAlive() as well
+Actor* StudentWorld::findActor(ActorHandle h) const {
+    return handles.lookup(h);
+}
+
+void StudentWorld::actorDied(Actor *a) {
+    if (a != socrates) // Socrates is not kept with the other actors
+        despawned.push_back(a);
+}
+
+// Only damageable actors are searched for by position; food has its own index, and pits and projectiles none
+SpatialGrid* StudentWorld::gridFor(Actor *a) {
+    if (!(a->getCategories() & (CATEGORY_BACTERIUM | CATEGORY_DESTRUCTABLE)))
+        return nullptr;
+    return (a->isStatic() ? &staticGrid : &dynamicGrid);
+}
+
+// Spawns are filed in the order they were made, after all existing actors
+void StudentWorld::commitSpawns() {
+    for (auto &a : spawned) {
+        if (SpatialGrid* g = gridFor(a))
+            g->insert(a);
+        if (a->isFood())
+            foodIndex.insert(a);
+    }
+    spawned.clear();
+}
+
+// Takes the dead actors out of whatever holds them and deletes them. Each one is found directly (its store index,
+// its grid cell, the food index), and the scheduler's buckets only hold the projectiles in flight, so the cost
+// depends on how many died rather than on how much dirt and food there is.
+void StudentWorld::commitDespawns() {
+    if (despawned.empty())
+        return;
+    for (auto &a : despawned) {
+        if (a->isBacterium()) {
+            bacteriaRemaining--;
+            bacteriaStore.remove(static_cast<Bacterium*>(a)->getStoreIndex());
+        }
+        if (a->isFood())
+            foodIndex.remove(a);
+        if (SpatialGrid* g = gridFor(a))
+            g->remove(a);
+    }
+    scheduler.removeDead();
+    for (auto &a : despawned) {
+        handles.release(a->getHandle());
+        ActorPools::destroy(a);
+    }
+    despawned.clear();
+}
+
+void StudentWorld::actorMoved(Actor *a, double oldX, double oldY) {
+    if (a == socrates)
+        pathsToSocratesStale = true; // the pursuers' paths now lead to where Socrates used to be
+    else if (a->isBacterium()) // the only filed actors that move
+        dynamicGrid.move(a, oldX, oldY);
+}
+
 void StudentWorld::addBacterium(int type, double x, double y) {
     bacteriaRemaining++;
     switch (type) {
         case REGULAR_SALMONELLA:
-            actors.push_back(new RegularSalmonella(this, x, y));
+            spawn<RegularSalmonella>(x, y);
             break;
         case AGGRESSIVE_SALMONELLA:
-            actors.push_back(new AggressiveSalmonella(this, x, y));
+            spawn<AggressiveSalmonella>(x, y);
             break;
         case ECOLI:
-            actors.push_back(new Ecoli(this, x, y));
+            spawn<Ecoli>(x, y);
             break;
         default:
             break;
@@ -48,55 +172,65 @@ void StudentWorld::addBacterium(int type, double x, double y) {
 int StudentWorld::init()
 {
     // Initialize Socrates
-    socrates = new Socrates(this);
+    socrates = pools.create<Socrates>(this);
+    layout.clear();
+    statusText.clear(); // so that the status line is set again for the new level
 
     // Add dirt piles first because they may overlap
     addInitObject(DIRT, max (180 - 20 * getLevel(), 20));
 
-    // Add bacteria pits
-    addInitObject(PIT, getLevel());
+    // Add bacteria pits; a level without all of its pits cannot be played as intended
+    int pits = getLevel();
+    if (addInitObject(PIT, pits) < pits)
+        return GWSTATUS_LEVEL_ERROR;
+
+    // Add food objects; running short of food only makes the level a little harder
+    int food = min(5 * getLevel(), 25);
+    int foodPlaced = addInitObject(FOOD, food);
+    if (foodPlaced < food)
+        cerr << "Level " << getLevel() << ": only room for " << foodPlaced << " of " << food << " food" << endl;
+    commitSpawns();
 
-    // Add food objects
-    addInitObject(FOOD, min(5 * getLevel(), 25));
-    
     bacteriaRemaining = 0;
     allBacteriaReleased = false;
+    pathsToSocratesStale = true;
+    obstaclesChanged = true;
+    ticksUntilGoodie = rng().trialsUntilOneIn(goodieChance());
+    ticksUntilFungus = rng().trialsUntilOneIn(fungusChance());
 
     return GWSTATUS_CONTINUE_GAME;
 }
 
-void StudentWorld::addInitObject(int type, int qty) {
-    int newAngle, newDist;
+// returns how many of the qty objects found a place in the dish
+int StudentWorld::addInitObject(int type, int qty) {
+    int placed = 0;
+    double newX, newY;
     for (int i = 0; i < qty; i++) {
-        newAngle = randInt(0, 359);
-        newDist = randInt(0, 120);
-        double newX = xCoordinateFromCenter(newDist, newAngle);
-        double newY = yCoordinateFromCenter(newDist, newAngle);
         switch (type) {
             case DIRT:
-                locations.push_back(make_pair(newX, newY));
-                actors.push_back(new DirtPile(this, newX, newY));
+                layout.placeAnywhere(newX, newY);
+                spawn<DirtPile>(newX, newY);
+                obstacles.addPile(newX, newY);
+                placed++;
                 break;
             case PIT:
-                if (safeToCreateObjectAt(newX, newY, locations)) {
-                    actors.push_back(new Pit(this, newX, newY));
-                    locations.push_back(make_pair(newX, newY));
+                if (layout.placeSpaced(newX, newY)) {
+                    Pit* p = spawn<Pit>(newX, newY);
+                    pitWakeups.schedule(p->getHandle(), p->ticksUntilNextAction());
+                    placed++;
                 }
-                else
-                    i--;
                 break;
             case FOOD:
-                if (safeToCreateObjectAt(newX, newY, locations)) {
-                    actors.push_back(new Food(this, newX, newY));
-                    locations.push_back(make_pair(newX, newY));
+                if (layout.placeSpaced(newX, newY)) {
+                    addFood(newX, newY);
+                    placed++;
                 }
-                else
-                    i--;
                 break;
             default:
                 break;
         }
     }
+    return placed;
 }
 
 int StudentWorld::move()
@@ -105,6 +239,7 @@ int StudentWorld::move()
     if (levelComplete())
         return GWSTATUS_FINISHED_LEVEL;
 
+    expireActors();
     socrates->doSomething(); // first Socrates gets a chance to do something
     if (!socrates->isAlive()) {
         playSound(SOUND_PLAYER_DIE);
@@ -112,61 +247,67 @@ int StudentWorld::move()
         return GWSTATUS_PLAYER_DIED;
     }
 
-    int chanceGoodie = max(510 - getLevel() * 10, 250);
-    if (randInt(0, chanceGoodie - 1) == 0) {
+    // the ticks between goodies, and between fungi, are drawn when the previous one appears
+    if (--ticksUntilGoodie == 0) {
+        ticksUntilGoodie = rng().trialsUntilOneIn(goodieChance());
         int typeOfGoodie = randInt(1, 10);
         int newGoodieAngle = randInt(0, 359);
         switch(typeOfGoodie) {
             case 1: // 1/10 cases gives us a 10% chance for an extra life goodie
-                actors.push_back(new ExtraLifeGoodie(this, xCoordinateFromCenter(VIEW_RADIUS, newGoodieAngle),
-                        yCoordinateFromCenter(VIEW_RADIUS, newGoodieAngle)));
+                spawn<ExtraLifeGoodie>(xCoordinateFromCenter(VIEW_RADIUS, newGoodieAngle),
+                        yCoordinateFromCenter(VIEW_RADIUS, newGoodieAngle));
                 break;
             case 2: // three cases gives us a 30% chance that the goodie is a flame thrower goodie
             case 3:
             case 4:
-                actors.push_back(new FlameThrowerGoodie(this, xCoordinateFromCenter(VIEW_RADIUS, newGoodieAngle),
-                                                     yCoordinateFromCenter(VIEW_RADIUS, newGoodieAngle)));
+                spawn<FlameThrowerGoodie>(xCoordinateFromCenter(VIEW_RADIUS, newGoodieAngle),
+                                                     yCoordinateFromCenter(VIEW_RADIUS, newGoodieAngle));
                 break;
             default: // otherwise we introduce a restore health goodie
-                actors.push_back(new RestoreHealthGoodie(this, xCoordinateFromCenter(VIEW_RADIUS, newGoodieAngle),
-                                                     yCoordinateFromCenter(VIEW_RADIUS, newGoodieAngle)));
+                spawn<RestoreHealthGoodie>(xCoordinateFromCenter(VIEW_RADIUS, newGoodieAngle),
+                                                     yCoordinateFromCenter(VIEW_RADIUS, newGoodieAngle));
                 break;
         }
     }
     
-    int chanceFungus = randInt(0, (max(510 - getLevel() * 10, 200)) - 1);
-    if (chanceFungus == 0) {
+    if (--ticksUntilFungus == 0) {
+        ticksUntilFungus = rng().trialsUntilOneIn(fungusChance());
         int newFungusAngle = randInt(0, 359);
-        actors.push_back(new Fungus(this, xCoordinateFromCenter(VIEW_RADIUS, newFungusAngle), yCoordinateFromCenter(VIEW_RADIUS, newFungusAngle)));
+        spawn<Fungus>(xCoordinateFromCenter(VIEW_RADIUS, newFungusAngle), yCoordinateFromCenter(VIEW_RADIUS, newFungusAngle));
     }
     
-    vector<Actor*>::iterator p; // iterator to get pointers to dead actors
-    vector<Actor*> toBeDeleted; // vector for pointers to dead actors to be deleted
-    
-    for (auto &it : actors) // give all live actors a chance to do something
-        if (it->isAlive())
-            it->doSomething();
-    
-    
-    // To cleanse all dead actors, we store pointers to them in a vector and then delete each of those pointers
-    // We process dead actors after alive ones have acted because actors affect each other's alive/dead status
-    for (p = actors.begin(); p != actors.end(); ) {
-        if (!(*p)->isAlive()) {
-            if ((*p)->isBacterium())
-                bacteriaRemaining--;
-            toBeDeleted.push_back(*p);
-            actors.erase(p); // erase() automatically sets p to point to the next element in the vector, so we do not increment it
-            continue;
-        }
-        p++;
+    // Socrates' projectiles and the new goodies join before the update phase, so they act this tick like before
+    commitSpawns();
+
+    // update phase: actors born now wait in the spawn buffer and actors that die stay in place, so the
+    // vector is never modified while it is walked; the pits due to release a bacterium go first, then the scheduler
+    // runs sprays and flame bursts, each kind as one batch, then Socrates picks up the goodies he touches and all
+    // bacteria act at once from their packed state. Given workers, the sprays and then the bacteria each first decide
+    // in parallel against the world as it stands and then commit what they decided in order, see BacteriaStore.h
+    wakePits();
+    if (workers == nullptr) {
+        scheduler.run();
+        giveGoodiesToSocrates();
+        bacteriaStore.update();
+    }
+    else {
+        scheduler.runInTwoPhases(*workers);
+        giveGoodiesToSocrates();
+        bacteriaStore.updateInTwoPhases(*workers);
+    }
+
+    // We process dead actors after alive ones have acted because actors affect each other's alive/dead status;
+    // newborns are merged first, so that one that already died is removed along with the rest, and act from next tick
+    commitSpawns();
+    commitDespawns();
+
+    // the status line is formatted into a fixed buffer and only passed on when something in it changed
+    char text[STATUS_TEXT_SIZE];
+    snprintf(text, sizeof(text), "Score: %d  Level: %d  Lives: %d  Health: %d  Sprays: %d  Flames: %d", getScore(), getLevel(), getLives(), socrates->getHitpoints(), socrates->getSpraysLeft(), socrates->getFlamesLeft());
+    if (statusText != text) {
+        statusText = text;
+        setGameStatText(statusText);
     }
-    
-    // deleting the pointers to each of the dead actors
-    for (auto &it : toBeDeleted)
-        delete it;
-    toBeDeleted.clear(); // clear out the pointers to deleted objects for the next tick
-    
-    setGameStatText("Score: " + to_string(getScore()) + "  Level: " + to_string(getLevel()) + "  Lives: " + to_string(getLives()) + "  Health: " + to_string(socrates->getHitpoints()) + "  Sprays: " + to_string(socrates->getSpraysLeft()) + "  Flames: " + to_string(socrates->getFlamesLeft()));
     return GWSTATUS_CONTINUE_GAME;
 }
 
@@ -176,73 +317,153 @@ void StudentWorld::signalThatAllBacteriaReleased() {
 
 void StudentWorld::cleanUp()
 {
-    if (socrates != nullptr) {
-        delete socrates; // delete the socrates object
-        socrates = nullptr; // set the socrates pointer to null so that it is not deleted again when called by the destructor
-    }
-    for (auto &p : actors)
-        delete p;
-    actors.clear();
+    // every actor of the level, Socrates included, and the level layout live in the arena, so the whole level is
+    // dropped at once instead of being destroyed one object at a time
+    renderList().forgetAll();
+    socrates = nullptr;
+    spawned.clear();
+    despawned.clear();
+    bacteriaStore.clear();
+    scheduler.clear();
+    handles.clear();
+    lifetimes.clear();
+    pitWakeups.clear();
+    pools.reset();
+    arena.reset();
+
+    // the indexes have a fixed number of cells, so emptying them does not depend on how many actors there were
+    staticGrid.clear();
+    dynamicGrid.clear();
+    foodIndex.clear();
+    obstacles.clear();
 }
 
-Actor* StudentWorld::overlap(Actor *a) {
-    vector<Actor*>::iterator p;
-    for (p = actors.begin(); p != actors.end(); p++) { // we first check for bacterium
-        if (distance(a->getX(), a->getY(), (*p)->getX(), (*p)->getY()) <= SPRITE_WIDTH && (*p)->isBacterium())
-            return (*p);
-    }
-    for (p = actors.begin(); p != actors.end(); p++) { // if not bacterium, we look for damageable objects
-        if (distance(a->getX(), a->getY(), (*p)->getX(), (*p)->getY()) <= SPRITE_WIDTH && (*p)->isDestructable()) {
-            return (*p);
-        }
-    }
-    return nullptr;
+// every damageable actor that something moving from (x0, y0) to (x1, y1) touches on the way, in the order it meets them
+void StudentWorld::overlapAlongPath(double x0, double y0, double x1, double y1, vector<Actor*> &result) {
+    result.clear();
+    dynamicGrid.nearSegment(x0, y0, x1, y1, SPRITE_WIDTH, CATEGORY_BACTERIUM | CATEGORY_DESTRUCTABLE, result);
+    staticGrid.nearSegment(x0, y0, x1, y1, SPRITE_WIDTH, CATEGORY_DESTRUCTABLE, result);
+    SpatialGrid::orderAlongSegment(x0, y0, x1, y1, result.begin(), result.end());
 }
 
-bool StudentWorld::overlapWithSocrates(Actor *a) {
-    return (distance(socrates->getX(), socrates->getY(), a->getX(), a->getY()) <= SPRITE_WIDTH);
+Actor* StudentWorld::firstOverlapAlongPath(double x0, double y0, double x1, double y1) {
+    return firstOverlapAlongPath(x0, y0, x1, y1, pathHits);
 }
 
-bool StudentWorld::overlapWithFood(Actor *a) {
-    for (auto &it : actors) {
-        if (it->isFood() && (distance(it->getX(), it->getY(), a->getX(), a->getY()) <= SPRITE_WIDTH)) {
-            it->setDead();
-            return true;
-        }
-    }
-    return false;
+// what a projectile moving from (x0, y0) to (x1, y1) hits: the first bacterium on the way, which takes priority over
+// dirt and goodies however far along it is, or else the first damageable actor on the way
+Actor* StudentWorld::firstOverlapAlongPath(double x0, double y0, double x1, double y1, vector<Actor*> &scratch) {
+    overlapAlongPath(x0, y0, x1, y1, scratch);
+    for (Actor* a : scratch)
+        if (a->isBacterium())
+            return a;
+    return (scratch.empty() ? nullptr : scratch.front());
 }
 
-bool StudentWorld::findNearbyFoodDirection(Actor *a, Direction &result) {
-    for (auto &it : actors) {
-        if (it->isFood() && (distance(it->getX(), it->getY(), a->getX(), a->getY()) <= 128)) {
-            result = (int) angleBetweenPositions(it->getX(), it->getY(), a->getX(), a->getY());
-            return true;
-        }
+// every live actor of the given categories whose center lies within r of (x, y), in no particular order
+void StudentWorld::actorsWithinRadius(double x, double y, double r, int categories, vector<Actor*> &result) {
+    result.clear();
+    dynamicGrid.withinRadius(x, y, r, categories, result);
+    staticGrid.withinRadius(x, y, r, categories, result);
+}
+
+// every live actor of the given categories whose center lies between inner and outer away from (x, y); the result
+// stays valid until the next call
+const vector<Actor*>& StudentWorld::actorsInRing(double x, double y, double inner, double outer, int categories) {
+    actorsWithinRadius(x, y, outer, categories, ringHits);
+    if (inner > 0) {
+        auto last = remove_if(ringHits.begin(), ringHits.end(), [&](Actor* a) {
+            return distanceSquared(a->getX(), a->getY(), x, y) < inner * inner;
+        });
+        ringHits.erase(last, ringHits.end());
     }
-    return false;
+    return ringHits;
+}
+
+bool StudentWorld::overlapWithSocrates(double x, double y) {
+    return (squaredDistanceToSocrates(x, y) <= SPRITE_WIDTH * SPRITE_WIDTH);
+}
+
+// the closest uneaten food that a bacterium at (x, y) overlaps, if there is any
+Actor* StudentWorld::foodAt(double x, double y) {
+    return foodIndex.nearest(x, y, SPRITE_WIDTH, CATEGORY_FOOD);
+}
+
+// points towards the closest food within 128 pixels other than skip, if there is any
+bool StudentWorld::findNearbyFoodDirection(double x, double y, Direction &result, const Actor* skip) {
+    Actor* food = foodIndex.nearest(x, y, 128, CATEGORY_FOOD, skip);
+    if (food == nullptr)
+        return false;
+    result = angleBetweenPositions(food->getX(), food->getY(), x, y);
+    return true;
 }
 
-bool StudentWorld::findSocratesNearby(Actor* a, int dist, Direction &result) {
-    if (distanceToSocrates(a) <= dist) {
-        result = (int) angleBetweenPositions(socrates->getX(), socrates->getY(), a->getX(), a->getY());
+bool StudentWorld::findSocratesNearby(double x, double y, int dist, Direction &result) {
+    if (squaredDistanceToSocrates(x, y) <= dist * dist) {
+        result = angleBetweenPositions(socrates->getX(), socrates->getY(), x, y);
         return true;
     }
     return false;
 }
 
+// like findSocratesNearby, but the direction follows the shortest path around the dirt piles instead of the straight line
+bool StudentWorld::findPathToSocrates(double x, double y, int dist, Direction &result) {
+    if (squaredDistanceToSocrates(x, y) > dist * dist)
+        return false;
+
+    // the field is only rebuilt for the first pursuer that asks after Socrates moved or the dirt changed
+    updatePathsToSocrates();
+    if (!pathsToSocrates.direction(x, y, result))
+        result = angleBetweenPositions(socrates->getX(), socrates->getY(), x, y);
+    return true;
+}
+
+// rebuilds the paths to Socrates if he moved or the dirt changed since they were built; after this they are only
+// read until one of those happens again, which lets several threads follow them at once
+void StudentWorld::updatePathsToSocrates() {
+    if (obstaclesChanged) {
+        pathsToSocrates.setObstacles(obstacles);
+        obstaclesChanged = false;
+        pathsToSocratesStale = true;
+    }
+    if (pathsToSocratesStale) {
+        pathsToSocrates.build(socrates->getX(), socrates->getY());
+        pathsToSocratesStale = false;
+    }
+}
+
 bool StudentWorld::movementOverlap(double x, double y) {
-    if (distance(x, y, VIEW_WIDTH / 2, VIEW_HEIGHT / 2) >= VIEW_RADIUS)
-        return true;
-    for (auto &it : actors) {
-        if (it->blocksMovement() && (distance(it->getX(), it->getY(), x, y)) <= (SPRITE_WIDTH / 2))
+    switch (obstacles.classify(x, y)) {
+        case ObstacleMap::BLOCKED:
             return true;
+        case ObstacleMap::FREE:
+            return false;
+        default: // a dirt pile only partly covers this pixel, so check the nearby piles exactly
+            return (staticGrid.findBest(x, y, SPRITE_WIDTH / 2, {CATEGORY_BLOCKER}) != nullptr);
+    }
+}
+
+// tries the headings start, start + step, start + 2 * step, ... in one pass and reports the first one along which
+// the actor can move the given number of units
+bool StudentWorld::firstOpenHeading(double x, double y, Direction start, int units, int step, int tries, Direction &result) {
+    for (int i = 0; i < tries; i++) {
+        Direction d = (start + i * step) % 360;
+        if (!movementOverlap(x + units * cosDegrees(d), y + units * sinDegrees(d))) {
+            result = d;
+            return true;
+        }
     }
     return false;
 }
 
-double StudentWorld::distanceToSocrates(Actor *a) {
-    return (distance(socrates->getX(), socrates->getY(), a->getX(), a->getY()));
+// called once when a dirt pile is destroyed so that bacteria can move through the space it occupied
+void StudentWorld::removeObstacle(Actor *a) {
+    obstacles.removePile(a->getX(), a->getY());
+    obstaclesChanged = true;
+}
+
+double StudentWorld::squaredDistanceToSocrates(double x, double y) {
+    return (distanceSquared(socrates->getX(), socrates->getY(), x, y));
 }
 
 void StudentWorld::adjustSocratesHitPoints(int hp) {
@@ -256,28 +477,25 @@ void StudentWorld::adjustSocratesFlames(int qty) {
 void StudentWorld::addProjectile(double x, double y, int dir, int type) {
     switch (type) {
         case SPRAY:
-            actors.push_back(new Spray(this, x, y, dir));
-            break;
-        case FLAME:
-            actors.push_back(new Flame(this, x, y, dir));
+            spawn<Spray>(x, y, dir);
             break;
         default:
             break;
     }
 }
 
+void StudentWorld::addFlameBurst(double x, double y, int dir) {
+    spawn<FlameBurst>(x, y, dir);
+}
+
 void StudentWorld::addFood(double x, double y) {
-    actors.push_back(new Food(this, x, y));
+    spawn<Food>(x, y); // filed in the food index as well when it is merged
 }
 
-StudentWorld::~StudentWorld() {
-    cleanUp(); // cleanup does the work of the destructor
+vector<SlabPool::Stats> StudentWorld::poolStats() const {
+    return pools.stats();
 }
 
-bool safeToCreateObjectAt(double x, double y, const LocationArray& l) {
-    for (auto &it : l) {
-        if (distance(it.first, it.second, x, y) <= SPRITE_WIDTH)
-            return false;
-    }
-    return true;
+StudentWorld::~StudentWorld() {
+    cleanUp(); // cleanup does the work of the destructor
 }
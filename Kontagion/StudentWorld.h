@@ -3,6 +3,15 @@
 
 #include "GameWorld.h"
 #include "Actor.h"
+#include "SpatialGrid.h"
+#include "ObstacleMap.h"
+#include "FlowField.h"
+#include "LevelLayout.h"
+#include "SlabPool.h"
+#include "BacteriaStore.h"
+#include "UpdateScheduler.h"
+#include "TimerWheel.h"
+#include "WorkerPool.h"
 #include <string>
 #include <vector>
 
@@ -10,7 +19,6 @@
 #define PIT 2
 #define FOOD 3
 #define SPRAY 1
-#define FLAME 2
 typedef std::pair<double,double> Location;
 typedef std::vector<Location> LocationArray;
 
@@ -19,32 +27,86 @@ typedef std::vector<Location> LocationArray;
 class StudentWorld : public GameWorld
 {
 public:
-    StudentWorld(std::string assetPath);
+    StudentWorld(std::string assetPath, uint64_t seed);
     virtual int init();
     virtual int move();
     virtual void cleanUp();
     void addProjectile(double x, double y, int dir, int type);
+    void addFlameBurst(double x, double y, int dir);
     void addFood(double x, double y);
-    Actor* overlap (Actor* a);
-    bool overlapWithSocrates (Actor *a);
-    bool overlapWithFood (Actor *a);
-    bool findNearbyFoodDirection(Actor* a, Direction &result);
-    bool findSocratesNearby(Actor* a, int dist, Direction &result);
+    Actor* firstOverlapAlongPath (double x0, double y0, double x1, double y1);
+    Actor* firstOverlapAlongPath (double x0, double y0, double x1, double y1, std::vector<Actor*> &scratch);
+    void overlapAlongPath (double x0, double y0, double x1, double y1, std::vector<Actor*> &result);
+    void actorsWithinRadius (double x, double y, double r, int categories, std::vector<Actor*> &result);
+    const std::vector<Actor*>& actorsInRing (double x, double y, double inner, double outer, int categories);
+    bool overlapWithSocrates (double x, double y);
+    Actor* foodAt (double x, double y);
+    bool findNearbyFoodDirection(double x, double y, Direction &result, const Actor* skip = nullptr);
+    bool findSocratesNearby(double x, double y, int dist, Direction &result);
+    bool findPathToSocrates(double x, double y, int dist, Direction &result);
+    void updatePathsToSocrates();
     bool movementOverlap (double x, double y);
+    bool firstOpenHeading (double x, double y, Direction start, int units, int step, int tries, Direction &result);
+    void removeObstacle (Actor* a);
     void adjustSocratesHitPoints(int hp);
     void adjustSocratesFlames(int qty);
     void signalThatAllBacteriaReleased();
     void addBacterium(int type, double x, double y);
+    void actorMoved(Actor* a, double oldX, double oldY);
+    void actorDied(Actor* a);
+    Actor* findActor(ActorHandle h) const;
+    BacteriaStore& bacteria() { return bacteriaStore; }
+    const Socrates* player() const { return socrates; } // nullptr between levels
+    void setWorkers(WorkerPool* pool) { workers = pool; } // non-null runs sprays and bacteria in two phases on pool
+    std::vector<SlabPool::Stats> poolStats() const; // occupancy of the pool behind each kind of actor created so far
     virtual ~StudentWorld();
 
 private:
+    LevelArena arena; // everything that lives exactly as long as a level; declared first so that it is destroyed last
+    ActorPools pools; // every actor is created in these, from slabs taken from the arena
     Socrates* socrates;
-    std::vector<Actor *> actors;
-    LocationArray locations;
+    BacteriaStore bacteriaStore; // state of every bacterium, run as one batch each tick
+    UpdateScheduler scheduler; // every other actor that acts each tick, bucketed by kind
+    WorkerPool* workers; // threads for the two-phase tick, or nullptr for the ordinary one
+    std::vector<Actor *> spawned; // actors created since the last merge, not yet in the spatial indexes
+    std::vector<Actor *> despawned; // actors that died since the last merge, still in the indexes until then
+    HandleTable handles; // every spawned actor's handle, released when the actor is deleted
+    TimerWheel lifetimes; // when each actor with a limited lifetime is due to expire
+    TimerWheel pitWakeups; // the next tick on which each pit releases a bacterium, or goes away once empty
+    std::vector<ActorHandle> dueTimers; // scratch space for the handles whose timers fired this tick
+    int ticksUntilGoodie; // the next goodie and fungus appear this many ticks from now
+    int ticksUntilFungus;
+    SpatialGrid staticGrid; // damageable actors that never move, i.e. the dirt piles
+    SpatialGrid dynamicGrid; // damageable actors that move or come and go, i.e. bacteria and goodies
+    SpatialGrid foodIndex; // index over uneaten food only, so foraging never has to look at anything else
+    ObstacleMap obstacles; // rasterized rim and dirt piles, answers movement collision tests by table lookup
+    FlowField pathsToSocrates; // shortest paths around the dirt to Socrates, shared by every pursuer
+    bool pathsToSocratesStale; // set whenever Socrates moves or a dirt pile disappears
+    bool obstaclesChanged; // set whenever a dirt pile appears or disappears
+    std::vector<Actor*> pathHits; // scratch space for firstOverlapAlongPath, kept to avoid reallocating every call
+    std::vector<Actor*> ringHits; // result of the last actorsInRing call, reused the same way
+    LevelLayout layout; // where this level's dirt, pits and food went, so that pits and food are spread out
+    std::string statusText; // last text shown in the status line, which only has to be replaced when it changes
     int bacteriaRemaining;
     bool allBacteriaReleased;
-    double distanceToSocrates (Actor *a);
-    void addInitObject (int type, int qty);
+    double squaredDistanceToSocrates (double x, double y);
+    void addActor (Actor *a);
+    template <typename T, typename... Args>
+    T* spawn (Args&&... args) { // creates an actor of type T in its pool and adds it to the world
+        T* a = pools.create<T>(this, std::forward<Args>(args)...);
+        addActor(a);
+        scheduler.add(a); // the static type picks the bucket
+        return a;
+    }
+    SpatialGrid* gridFor (Actor* a); // the grid a is filed in, or nullptr for actors that are never searched for
+    void expireActors ();
+    void wakePits ();
+    int goodieChance () const { return std::max(510 - getLevel() * 10, 250); } // a goodie appears with 1 in this many chance each tick
+    int fungusChance () const { return std::max(510 - getLevel() * 10, 200); } // same for a fungus
+    void giveGoodiesToSocrates ();
+    void commitSpawns ();
+    void commitDespawns ();
+    int addInitObject (int type, int qty);
     bool levelComplete() const;
 };
 
@@ -0,0 +1,64 @@
+#include "TimerWheel.h"
+
+using namespace std;
+
+namespace {
+    const int RESERVED_PER_SLOT = 4;
+}
+
+TimerWheel::TimerWheel() {
+    m_now = 0;
+
+    // room for a few timers per slot up front, so that a slot does not allocate the first time timers pile up in it
+    for (auto &level : m_slots)
+        for (auto &slot : level)
+            slot.reserve(RESERVED_PER_SLOT);
+}
+
+void TimerWheel::schedule(ActorHandle h, int ticks) {
+    place(Timer{h, m_now + (uint32_t) (ticks < 1 ? 1 : ticks)});
+}
+
+void TimerWheel::advance(vector<ActorHandle> &due) {
+    m_now++;
+
+    // when a wheel comes full circle the next slot of the coarser wheel is spread over it, coarsest first
+    int level = 0;
+    while (level + 1 < LEVELS && ((m_now >> (level * BITS_PER_LEVEL)) & (SLOTS - 1)) == 0)
+        level++;
+    for ( ; level > 0; level--)
+        cascade(level);
+
+    vector<Timer> &slot = m_slots[0][m_now & (SLOTS - 1)];
+    for (const Timer &t : slot)
+        due.push_back(t.handle);
+    slot.clear();
+}
+
+void TimerWheel::clear() {
+    for (auto &wheel : m_slots)
+        for (auto &slot : wheel)
+            slot.clear();
+    m_now = 0;
+}
+
+void TimerWheel::place(const Timer &t) {
+    uint32_t ahead = t.deadline - m_now;
+    for (int level = 0; level < LEVELS; level++) {
+        int shift = level * BITS_PER_LEVEL;
+        if ((ahead >> shift) < (uint32_t) SLOTS || level == LEVELS - 1) {
+            // a timer too far off for the last wheel waits in the slot it passes through last before coming round
+            uint32_t at = ((ahead >> shift) < (uint32_t) SLOTS ? t.deadline : m_now - (1u << shift));
+            m_slots[level][(at >> shift) & (SLOTS - 1)].push_back(t);
+            return;
+        }
+    }
+}
+
+void TimerWheel::cascade(int level) {
+    vector<Timer> &slot = m_slots[level][(m_now >> (level * BITS_PER_LEVEL)) & (SLOTS - 1)];
+    // these timers are all due before this slot comes round again, so none of them is filed back into it
+    for (const Timer &t : slot)
+        place(t);
+    slot.clear();
+}
@@ -0,0 +1,37 @@
+#ifndef TIMERWHEEL_H_
+#define TIMERWHEEL_H_
+
+#include "ActorHandle.h"
+#include <vector>
+#include <cstdint>
+
+// Hierarchical timer wheel counting in ticks. A timer due within the next 64 ticks sits in the slot of the first
+// wheel for its exact tick; later ones sit in the slot of a coarser wheel for the range of ticks they fall in, and
+// are moved one wheel down when the finer wheel comes round to that range. Scheduling, expiring and each move
+// between wheels are all constant time, so a timer costs nothing on the ticks in between. Timers are not cancelled:
+// the handle of an actor that is gone by the time its timer fires is simply stale.
+class TimerWheel {
+public:
+    TimerWheel();
+    void schedule(ActorHandle h, int ticks); // fires on the advance() that is ticks (at least 1) advances away
+    void advance(std::vector<ActorHandle>& due); // moves on one tick and appends the handles whose time has come
+    void clear(); // drops every timer and starts counting from zero again
+
+private:
+    static const int BITS_PER_LEVEL = 6;
+    static const int SLOTS = 1 << BITS_PER_LEVEL; // slots in each wheel
+    static const int LEVELS = 3; // wheels, enough for timers up to 2^18 ticks; later ones wait in the last wheel
+
+    struct Timer {
+        ActorHandle handle;
+        uint32_t deadline; // tick at which the timer fires
+    };
+
+    uint32_t m_now; // ticks advanced since the last clear
+    std::vector<Timer> m_slots[LEVELS][SLOTS];
+
+    void place(const Timer &t);
+    void cascade(int level); // moves the timers of the current slot of a wheel down to the finer wheels
+};
+
+#endif // TIMERWHEEL_H_
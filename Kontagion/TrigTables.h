@@ -0,0 +1,108 @@
+#ifndef TRIGTABLES_H_
+#define TRIGTABLES_H_
+
+#include <cmath>
+
+// Every direction in the game is a whole number of degrees, so sines and cosines come out of tables that are
+// computed once by the compiler, and the direction from one point to another is found by comparing against a
+// table of tangents instead of calling atan2.
+
+struct TrigTable {
+    double sine[360];
+    double cosine[360];
+    double tangent[46]; // tangents of 0 through 45 degrees
+};
+
+// Taylor series, accurate to the last bit for the angles of at most 45 degrees it is used with
+constexpr double taylorSine(double r) {
+    double term = r, sum = r;
+    for (int n = 1; n < 20; n++) {
+        term = -term * r * r / ((2 * n) * (2 * n + 1));
+        sum += term;
+    }
+    return sum;
+}
+
+constexpr double taylorCosine(double r) {
+    double term = 1, sum = 1;
+    for (int n = 1; n < 20; n++) {
+        term = -term * r * r / ((2 * n - 1) * (2 * n));
+        sum += term;
+    }
+    return sum;
+}
+
+// sine of a whole number of degrees between 0 and 90, always evaluated at an angle of at most 45 degrees
+constexpr double firstQuadrantSine(int degrees) {
+    const double radiansPerDegree = 3.14159265358979323846 / 180;
+    if (degrees <= 45)
+        return taylorSine(degrees * radiansPerDegree);
+    return taylorCosine((90 - degrees) * radiansPerDegree);
+}
+
+constexpr TrigTable makeTrigTable() {
+    TrigTable t{};
+    for (int d = 0; d < 360; d++) {
+        if (d <= 90)
+            t.sine[d] = firstQuadrantSine(d);
+        else if (d <= 180)
+            t.sine[d] = firstQuadrantSine(180 - d);
+        else if (d <= 270)
+            t.sine[d] = -firstQuadrantSine(d - 180);
+        else
+            t.sine[d] = -firstQuadrantSine(360 - d);
+    }
+    for (int d = 0; d < 360; d++)
+        t.cosine[d] = t.sine[(d + 90) % 360];
+    for (int d = 0; d <= 45; d++)
+        t.tangent[d] = t.sine[d] / t.cosine[d];
+    return t;
+}
+
+inline constexpr TrigTable TRIG_TABLE = makeTrigTable();
+
+inline int normalizeDegrees(int degrees) {
+    degrees %= 360;
+    return (degrees < 0 ? degrees + 360 : degrees);
+}
+
+inline double sinDegrees(int degrees) {
+    return TRIG_TABLE.sine[normalizeDegrees(degrees)];
+}
+
+inline double cosDegrees(int degrees) {
+    return TRIG_TABLE.cosine[normalizeDegrees(degrees)];
+}
+
+// (int) (atan2(y, x) * 180 / pi): the direction of (x, y) in whole degrees, truncated towards zero
+inline int quantizedAtan2(double y, double x) {
+    const double nearWholeDegree = 1e-9; // far wider than the rounding error of either method
+
+    // reduce to the angle between the vector and the nearest axis, whose tangent is at most 1
+    double ax = std::fabs(x), ay = std::fabs(y);
+    bool steep = ay > ax;
+    double t = (steep ? ax / ay : ay / ax);
+
+    // binary search for the whole degree k with tan(k) <= t < tan(k + 1)
+    int low = 0, high = 45;
+    while (low < high) {
+        int mid = (low + high + 1) / 2;
+        if (TRIG_TABLE.tangent[mid] <= t)
+            low = mid;
+        else
+            high = mid - 1;
+    }
+
+    // on (or next to) a whole degree the result depends on how the libm version rounds, so let it decide;
+    // this also covers the axes and the zero vector
+    if (!(t >= 0) || t - TRIG_TABLE.tangent[low] < nearWholeDegree || (low < 45 && TRIG_TABLE.tangent[low + 1] - t < nearWholeDegree))
+        return (int) (std::atan2(y, x) * (180 / (4 * std::atan(1.0))));
+
+    // the angle now lies strictly between two whole degrees, so mirroring it keeps the truncation easy
+    int degrees = (steep ? 89 - low : low);
+    if (x < 0)
+        degrees = 179 - degrees;
+    return (std::signbit(y) ? -degrees : degrees);
+}
+
+#endif // TRIGTABLES_H_
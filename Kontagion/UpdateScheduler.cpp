@@ -0,0 +1,66 @@
+#include "UpdateScheduler.h"
+#include "WorkerPool.h"
+#include <algorithm>
+
+using namespace std;
+
+namespace {
+    const int BLOCK = 16; // sprays looked at by one thread at a time; each search is fairly long
+    const int RESERVED_SPRAYS = 64; // room in the buckets before they first grow
+    const int RESERVED_FLAME_BURSTS = 8;
+    const int RESERVED_HITS = 64; // room in each worker's search results before they first grow
+
+    template <typename T>
+    void dropDead(vector<T*> &bucket) {
+        bucket.erase(remove_if(bucket.begin(), bucket.end(), [](T* a) { return !a->isAlive(); }), bucket.end());
+    }
+}
+
+UpdateScheduler::UpdateScheduler() {
+    m_sprays.reserve(RESERVED_SPRAYS);
+    m_flameBursts.reserve(RESERVED_FLAME_BURSTS);
+}
+
+void UpdateScheduler::run() {
+    // the sizes are taken up front, so that an actor added to a bucket during the tick does not act in it yet
+    size_t n = m_sprays.size();
+    for (size_t i = 0; i < n; i++)
+        if (m_sprays[i]->isAlive())
+            m_sprays[i]->Spray::doSomething();
+    runFlameBursts();
+}
+
+void UpdateScheduler::runInTwoPhases(WorkerPool &workers) {
+    int n = (int) m_sprays.size();
+    m_targets.reserve(RESERVED_SPRAYS); // reserving does nothing once there is room, as there is after the first tick
+    m_targets.resize(n);
+    m_scratch.resize(workers.threads());
+    for (auto &hits : m_scratch)
+        hits.reserve(RESERVED_HITS);
+    workers.parallelFor(n, BLOCK, [&](int begin, int end, int worker) {
+        for (int i = begin; i < end; i++)
+            m_targets[i] = (m_sprays[i]->isAlive() ? m_sprays[i]->findTarget(m_scratch[worker]) : nullptr);
+    });
+    for (int i = 0; i < n; i++)
+        if (m_sprays[i]->isAlive())
+            m_sprays[i]->hitOrMove(m_targets[i]);
+    runFlameBursts();
+}
+
+void UpdateScheduler::runFlameBursts() {
+    size_t n = m_flameBursts.size();
+    for (size_t i = 0; i < n; i++)
+        if (m_flameBursts[i]->isAlive())
+            m_flameBursts[i]->FlameBurst::doSomething();
+}
+
+void UpdateScheduler::removeDead() {
+    dropDead(m_sprays);
+    dropDead(m_flameBursts);
+}
+
+void UpdateScheduler::clear() {
+    m_sprays.clear();
+    m_flameBursts.clear();
+    m_targets.clear();
+}
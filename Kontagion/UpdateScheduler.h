@@ -0,0 +1,46 @@
+#ifndef UPDATESCHEDULER_H_
+#define UPDATESCHEDULER_H_
+
+#include "Actor.h"
+#include <vector>
+
+class WorkerPool;
+
+// Keeps the actors that do something each tick in one bucket per kind of behavior and runs each bucket as a batch,
+// calling the behavior directly instead of through the virtual doSomething, so that a tick runs the same code over
+// and over instead of jumping between every kind of actor. Dirt piles, food and goodies never act and are not
+// scheduled at all; pits are woken by the world on the ticks they release a bacterium, bacteria are run by the
+// BacteriaStore and Socrates by the world itself.
+//
+// Phase order within run():
+//   1. sprays
+//   2. flame bursts
+// Within a bucket actors act in the order they were spawned. Actors added while run() is in progress wait until
+// the next tick.
+//
+// runInTwoPhases() splits the sprays in two: they all look for their target along the path they swept at the same
+// time, then hit it or move on one at a time, in order. A spray whose target was killed by an earlier one looks
+// again, and since nothing but deaths changes the world in between, each spray hits the same thing it would in
+// run(). Flame bursts are few and hit many things at once, so they always run as in run().
+class UpdateScheduler {
+public:
+    UpdateScheduler();
+    void add(Spray* a) { m_sprays.push_back(a); }
+    void add(FlameBurst* a) { m_flameBursts.push_back(a); }
+    void add(Actor*) {} // everything else is not run by the scheduler
+
+    void run();
+    void runInTwoPhases(WorkerPool &workers);
+    void removeDead(); // drops dead actors from the buckets, keeping the order of the rest
+    void clear();
+
+private:
+    std::vector<Spray*> m_sprays;
+    std::vector<FlameBurst*> m_flameBursts;
+    std::vector<Actor*> m_targets; // what each spray is about to hit, between the two phases
+    std::vector<std::vector<Actor*>> m_scratch; // search results, one buffer per worker
+
+    void runFlameBursts();
+};
+
+#endif // UPDATESCHEDULER_H_
@@ -0,0 +1,77 @@
+#include "WorkerPool.h"
+#include <algorithm>
+
+using namespace std;
+
+WorkerPool::WorkerPool(int threads) {
+    m_task = nullptr;
+    m_body = nullptr;
+    m_size = 0;
+    m_block = 1;
+    m_next = 0;
+    m_working = 0;
+    m_loop = 0;
+    m_stopping = false;
+    for (int worker = 1; worker < threads; worker++)
+        m_threads.emplace_back(&WorkerPool::work, this, worker);
+}
+
+WorkerPool::~WorkerPool() {
+    {
+        lock_guard<mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_started.notify_all();
+    for (auto &t : m_threads)
+        t.join();
+}
+
+void WorkerPool::run(int n, int block, Task task, void* body) {
+    if (block < 1)
+        block = 1;
+
+    // waking the other threads costs more than a single block of work
+    if (m_threads.empty() || n <= block) {
+        if (n > 0)
+            task(body, 0, n, 0);
+        return;
+    }
+
+    {
+        lock_guard<mutex> lock(m_mutex);
+        m_task = task;
+        m_body = body;
+        m_size = n;
+        m_block = block;
+        m_next = 0;
+        m_working = (int) m_threads.size();
+        m_loop++;
+    }
+    m_started.notify_all();
+    takeBlocks(0);
+
+    unique_lock<mutex> lock(m_mutex);
+    m_finished.wait(lock, [this] { return m_working == 0; });
+}
+
+void WorkerPool::work(int worker) {
+    unsigned done = 0;
+    for (;;) {
+        {
+            unique_lock<mutex> lock(m_mutex);
+            m_started.wait(lock, [&] { return m_stopping || m_loop != done; });
+            if (m_stopping)
+                return;
+            done = m_loop;
+        }
+        takeBlocks(worker);
+        lock_guard<mutex> lock(m_mutex);
+        if (--m_working == 0)
+            m_finished.notify_one();
+    }
+}
+
+void WorkerPool::takeBlocks(int worker) {
+    for (int begin = m_next.fetch_add(m_block); begin < m_size; begin = m_next.fetch_add(m_block))
+        m_task(m_body, begin, min(begin + m_block, m_size), worker);
+}
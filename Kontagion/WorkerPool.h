@@ -0,0 +1,54 @@
+#ifndef WORKERPOOL_H_
+#define WORKERPOOL_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// A fixed set of threads that share out the iterations of a loop with the thread running it. Iterations are handed
+// out a block at a time from a shared counter, so a thread that finishes early takes another block; which thread
+// runs an iteration therefore changes from run to run, and a loop body must only write to what belongs to its own
+// iterations, or to scratch space kept per worker. A pool runs one loop at a time and is not shared between
+// threads that run loops.
+class WorkerPool {
+public:
+    explicit WorkerPool(int threads); // threads in all, counting the caller's; with 1 every loop runs on the caller
+    ~WorkerPool();
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    int threads() const { return (int) m_threads.size() + 1; }
+
+    // calls body(begin, end, worker) on ranges of at most block iterations that together cover [0, n), and returns
+    // once they are all done; worker, from 0 to threads() - 1, is different for calls that can run at the same time
+    template <typename Body>
+    void parallelFor(int n, int block, Body &&body) {
+        typedef typename std::remove_reference<Body>::type B;
+        run(n, block, [](void* b, int begin, int end, int worker) { (*static_cast<B*>(b))(begin, end, worker); }, &body);
+    }
+
+private:
+    typedef void (*Task)(void* body, int begin, int end, int worker);
+
+    std::vector<std::thread> m_threads;
+    std::mutex m_mutex;
+    std::condition_variable m_started; // a new loop is there to work on, or the pool is being destroyed
+    std::condition_variable m_finished; // the last thread working on the loop is done
+    Task m_task;
+    void* m_body;
+    int m_size;
+    int m_block;
+    std::atomic<int> m_next; // first iteration not yet handed out
+    int m_working; // threads other than the caller that have not finished the current loop
+    unsigned m_loop; // counts the loops run, so that a thread can tell a new loop from a spurious wakeup
+    bool m_stopping;
+
+    void run(int n, int block, Task task, void* body);
+    void work(int worker); // what each thread of the pool runs until the pool is destroyed
+    void takeBlocks(int worker);
+};
+
+#endif // WORKERPOOL_H_
@@ -2,6 +2,8 @@
 #include <iostream>
 #include <fstream>
 #include <string>
+#include <random>
+#include <cstdint>
 using namespace std;
 
 #ifdef _MSC_VER
@@ -28,7 +30,7 @@ const string assetDirectory = "Assets";
 
 class GameWorld;
 
-GameWorld* createStudentWorld(string assetPath = "");
+GameWorld* createStudentWorld(string assetPath, uint64_t seed);
 
 int main(int argc, char* argv[])
 {
@@ -53,6 +55,9 @@ int main(int argc, char* argv[])
         }
     }
 
-    GameWorld* gw = createStudentWorld(assetPath);
+    // every game is different, but each is played out from one seed
+    random_device rd;
+    uint64_t seed = (uint64_t(rd()) << 32) | rd();
+    GameWorld* gw = createStudentWorld(assetPath, seed);
     Game().run(argc, argv, gw, "Kontagion");
 }